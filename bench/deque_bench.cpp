@@ -0,0 +1,462 @@
+/*!*****************************************************************************
+*\file     deque_bench.cpp
+*\author   Jalin A. Brown
+*\email    JalinBrownWorks@gmail.com
+
+*\brief Description:
+  Benchmark suite comparing WrapBuffer::Deque against std::deque,
+  std::vector and boost::circular_buffer (when Boost is available).
+
+  Workloads, each run at sizes from L1-resident to DRAM-resident:
+
+  1) push_back / push_front:  fill an empty container with n elements.
+  2) pop_back / pop_front:    drain a full container of n elements.
+  3) fifo:                    push_back + pop_front on a queue held at n.
+  4) random_read:             operator[] at pseudo-random positions.
+  5) reverse:                 reverse all n elements in place. The Deque's
+                              reverse() only flips a flag, so its row also
+                              calls normalize() to move the elements the
+                              way std::reverse does for the others.
+  6) append:                  operator+= (or insert) of n elements onto n.
+  7) oscillate:               swing between n/4 - 1 and n/2 + 1 elements,
+                              the pattern that makes a shrinking Deque
+                              reallocate on every swing.
+
+  Every result is reported as ns/op, where an op is one element pushed,
+  popped, read, reversed or appended, and as bytes copied per op. Bytes
+  copied come from a second, untimed run over an int wrapper that counts
+  its copy and move operations, so they include the element the operation
+  itself writes as well as everything moved by reallocation.
+
+  std::vector has no cheap front operations, so those rows are skipped for
+  it. boost::circular_buffer does not grow by itself; the adapter doubles
+  its capacity when full, the same policy the Deque uses.
+
+  Build and run from the repository root:
+    g++ -O2 -std=c++17 -I. bench/deque_bench.cpp -o deque_bench
+    ./deque_bench                     table on stdout
+    ./deque_bench --json out.json     table, plus JSON for diffing runs
+    ./deque_bench --quick             smaller sizes only
+
+******************************************************************************/
+
+//-----------------------------------------------------------------------------
+// Includes:
+//-----------------------------------------------------------------------------
+
+#include "deque.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <string>
+#include <vector>
+
+#if defined(__has_include)
+#if __has_include(<boost/circular_buffer.hpp>)
+#include <boost/circular_buffer.hpp>
+#define WRAPBUFFER_BENCH_BOOST 1
+#endif
+#endif
+
+//-----------------------------------------------------------------------------
+// Private Structures:
+//-----------------------------------------------------------------------------
+
+namespace {
+
+  using Clock = std::chrono::steady_clock;
+
+  // Copies and moves of Counted values since the last reset
+  std::uint64_t copies = 0;
+
+  // int that counts how often it is copied or moved
+  struct Counted
+  {
+    int value;
+
+    Counted() : value(0) {}
+    Counted(int v) : value(v) {}
+    Counted(const Counted& o) : value(o.value) { ++copies; }
+    Counted(Counted&& o) noexcept : value(o.value) { ++copies; }
+    Counted& operator=(const Counted& o) { value = o.value; ++copies; return *this; }
+    Counted& operator=(Counted&& o) noexcept { value = o.value; ++copies; return *this; }
+    operator int() const { return value; }
+  };
+
+  // Keep the optimizer from discarding a computed value
+  template <typename T>
+  void keep(const T& value)
+  {
+    asm volatile("" : : "g"(&value) : "memory");
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Uniform container interface, one specialization per contender
+  template <typename C>
+  struct Ops;
+
+  template <typename T>
+  struct Ops<WrapBuffer::Deque<T>>
+  {
+    using C = WrapBuffer::Deque<T>;
+    static constexpr bool has_front = true;
+    static const char* name() { return "WrapBuffer::Deque"; }
+    static void push_back(C& c, int v) { c.Push_back(T(v)); }
+    static void push_front(C& c, int v) { c.Push_front(T(v)); }
+    static int pop_back(C& c) { return c.Pop_back(); }
+    static int pop_front(C& c) { return c.Pop_front(); }
+    static int at(const C& c, std::size_t i) { return c[i]; }
+    static std::size_t size(const C& c) { return c.Size(); }
+    static void reverse(C& c) { c.reverse(); c.normalize(); }
+    static void append(C& c, const C& rhs) { c += rhs; }
+  };
+
+  template <typename T>
+  struct Ops<std::deque<T>>
+  {
+    using C = std::deque<T>;
+    static constexpr bool has_front = true;
+    static const char* name() { return "std::deque"; }
+    static void push_back(C& c, int v) { c.push_back(T(v)); }
+    static void push_front(C& c, int v) { c.push_front(T(v)); }
+    static int pop_back(C& c) { int v = c.back(); c.pop_back(); return v; }
+    static int pop_front(C& c) { int v = c.front(); c.pop_front(); return v; }
+    static int at(const C& c, std::size_t i) { return c[i]; }
+    static std::size_t size(const C& c) { return c.size(); }
+    static void reverse(C& c) { std::reverse(c.begin(), c.end()); }
+    static void append(C& c, const C& rhs) { c.insert(c.end(), rhs.begin(), rhs.end()); }
+  };
+
+  template <typename T>
+  struct Ops<std::vector<T>>
+  {
+    using C = std::vector<T>;
+    static constexpr bool has_front = false;
+    static const char* name() { return "std::vector"; }
+    static void push_back(C& c, int v) { c.push_back(T(v)); }
+    static void push_front(C&, int) {}
+    static int pop_back(C& c) { int v = c.back(); c.pop_back(); return v; }
+    static int pop_front(C&) { return 0; }
+    static int at(const C& c, std::size_t i) { return c[i]; }
+    static std::size_t size(const C& c) { return c.size(); }
+    static void reverse(C& c) { std::reverse(c.begin(), c.end()); }
+    static void append(C& c, const C& rhs) { c.insert(c.end(), rhs.begin(), rhs.end()); }
+  };
+
+#ifdef WRAPBUFFER_BENCH_BOOST
+  template <typename T>
+  struct Ops<boost::circular_buffer<T>>
+  {
+    using C = boost::circular_buffer<T>;
+    static constexpr bool has_front = true;
+    static const char* name() { return "boost::circular_buffer"; }
+    static void grow(C& c, std::size_t extra)
+    {
+      if (c.size() + extra > c.capacity())
+      {
+        c.set_capacity(std::max(c.capacity() * 2, c.size() + extra));
+      }
+    }
+    static void push_back(C& c, int v) { grow(c, 1); c.push_back(T(v)); }
+    static void push_front(C& c, int v) { grow(c, 1); c.push_front(T(v)); }
+    static int pop_back(C& c) { int v = c.back(); c.pop_back(); return v; }
+    static int pop_front(C& c) { int v = c.front(); c.pop_front(); return v; }
+    static int at(const C& c, std::size_t i) { return c[i]; }
+    static std::size_t size(const C& c) { return c.size(); }
+    static void reverse(C& c) { std::reverse(c.begin(), c.end()); }
+    static void append(C& c, const C& rhs) { grow(c, rhs.size()); c.insert(c.end(), rhs.begin(), rhs.end()); }
+  };
+#endif
+
+  //-------------------------------------------------------------------------
+
+  // One workload: runs on a container type, returns the number of ops done
+  struct Workload
+  {
+    const char* name;
+    bool needs_front;
+  };
+
+  const Workload workloads[] = {
+    { "push_back", false }, { "push_front", true }, { "pop_back", false }, { "pop_front", true },
+    { "fifo", true }, { "random_read", false }, { "reverse", false }, { "append", false },
+    { "oscillate", true },
+  };
+
+  //-------------------------------------------------------------------------
+
+  // Fill a fresh container with n elements
+  template <typename C>
+  void fill(C& c, std::size_t n)
+  {
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      Ops<C>::push_back(c, static_cast<int>(i));
+    }
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Run workload "w" at size n on container type C, returns ops performed.
+  // Only the part between start and stop is timed.
+  template <typename C>
+  std::size_t run(const std::string& w, std::size_t n, double& ns)
+  {
+    using O = Ops<C>;
+    const std::size_t rounds = std::max<std::size_t>(1, (1u << 22) / n);
+    std::size_t ops = 0;
+    long long sink = 0;
+    Clock::duration elapsed{};
+
+    for (std::size_t r = 0; r < rounds; ++r)
+    {
+      C c;
+      if (w != "push_back" && w != "push_front" && w != "oscillate")
+      {
+        fill(c, n);
+      }
+      C rhs;
+      std::vector<std::size_t> positions;
+      if (w == "append")
+      {
+        fill(rhs, n);
+      }
+      if (w == "random_read")
+      {
+        // xorshift positions, generated outside the timed region
+        positions.resize(n);
+        std::uint64_t x = 88172645463325252ull + r;
+        for (std::size_t& p : positions)
+        {
+          x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+          p = static_cast<std::size_t>(x % n);
+        }
+      }
+
+      auto start = Clock::now();
+      if (w == "push_back")
+      {
+        fill(c, n);
+        ops += n;
+      }
+      else if (w == "push_front")
+      {
+        for (std::size_t i = 0; i < n; ++i)
+        {
+          O::push_front(c, static_cast<int>(i));
+        }
+        ops += n;
+      }
+      else if (w == "pop_back")
+      {
+        for (std::size_t i = 0; i < n; ++i)
+        {
+          sink += O::pop_back(c);
+        }
+        ops += n;
+      }
+      else if (w == "pop_front")
+      {
+        for (std::size_t i = 0; i < n; ++i)
+        {
+          sink += O::pop_front(c);
+        }
+        ops += n;
+      }
+      else if (w == "fifo")
+      {
+        for (std::size_t i = 0; i < n; ++i)
+        {
+          O::push_back(c, static_cast<int>(i));
+          sink += O::pop_front(c);
+        }
+        ops += 2 * n;
+      }
+      else if (w == "random_read")
+      {
+        for (std::size_t p : positions)
+        {
+          sink += O::at(c, p);
+        }
+        ops += n;
+      }
+      else if (w == "reverse")
+      {
+        O::reverse(c);
+        ops += n;
+      }
+      else if (w == "append")
+      {
+        O::append(c, rhs);
+        ops += n;
+      }
+      else if (w == "oscillate")
+      {
+        const std::size_t low = n / 4 > 1 ? n / 4 : 2;
+        fill(c, low);
+        for (int swing = 0; swing < 4; ++swing)
+        {
+          while (O::size(c) <= 2 * low)
+          {
+            O::push_back(c, swing);
+            ops++;
+          }
+          while (O::size(c) >= low)
+          {
+            sink += O::pop_front(c);
+            ops++;
+          }
+        }
+      }
+      elapsed += Clock::now() - start;
+    }
+
+    keep(sink);
+    ns = std::chrono::duration<double, std::nano>(elapsed).count() / ops;
+    return ops;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // One row of results
+  struct Row
+  {
+    std::string container;
+    std::string workload;
+    std::size_t size;
+    double ns_per_op;
+    double bytes_per_op;
+  };
+
+  //-------------------------------------------------------------------------
+
+  // Time every workload at size n for the container family "C<T>"
+  template <template <typename...> class C>
+  void bench(std::size_t n, std::vector<Row>& rows)
+  {
+    using Timed = C<int>;
+    using Count = C<Counted>;
+
+    for (const Workload& w : workloads)
+    {
+      if (w.needs_front && !Ops<Timed>::has_front)
+      {
+        continue;
+      }
+
+      double ns = 0;
+      run<Timed>(w.name, n, ns);
+
+      // Same work again over Counted elements, only to count copies.
+      double ignored = 0;
+      copies = 0;
+      std::size_t ops = run<Count>(w.name, n, ignored);
+      double bytes = static_cast<double>(copies) * sizeof(int) / ops;
+
+      rows.push_back({ Ops<Timed>::name(), w.name, n, ns, bytes });
+      std::printf("%-24s %-12s %10zu %10.3f %12.2f\n", Ops<Timed>::name(), w.name, n, ns, bytes);
+      std::fflush(stdout);
+    }
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Write all rows as a JSON array of objects
+  bool write_json(const char* path, const std::vector<Row>& rows)
+  {
+    std::FILE* f = std::fopen(path, "w");
+    if (!f)
+    {
+      return false;
+    }
+
+    std::fprintf(f, "[\n");
+    for (std::size_t i = 0; i < rows.size(); ++i)
+    {
+      const Row& r = rows[i];
+      std::fprintf(f, "  {\"container\": \"%s\", \"workload\": \"%s\", \"size\": %zu, "
+                      "\"ns_per_op\": %.4f, \"bytes_copied_per_op\": %.4f}%s\n",
+                   r.container.c_str(), r.workload.c_str(), r.size, r.ns_per_op, r.bytes_per_op,
+                   (i + 1 < rows.size()) ? "," : "");
+    }
+    std::fprintf(f, "]\n");
+    return std::fclose(f) == 0;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // WrapBuffer::Deque with only the element type as a parameter
+  template <typename T>
+  using WrapDeque = WrapBuffer::Deque<T>;
+
+  template <typename T>
+  using StdDeque = std::deque<T>;
+
+  template <typename T>
+  using StdVector = std::vector<T>;
+
+#ifdef WRAPBUFFER_BENCH_BOOST
+  template <typename T>
+  using BoostRing = boost::circular_buffer<T>;
+#endif
+
+}
+
+//-----------------------------------------------------------------------------
+// Public Functions:
+//-----------------------------------------------------------------------------
+
+int main(int argc, char** argv)
+{
+  const char* json = nullptr;
+  bool quick = false;
+  for (int i = 1; i < argc; ++i)
+  {
+    if (std::strcmp(argv[i], "--json") == 0 && i + 1 < argc)
+    {
+      json = argv[++i];
+    }
+    else if (std::strcmp(argv[i], "--quick") == 0)
+    {
+      quick = true;
+    }
+    else
+    {
+      std::fprintf(stderr, "usage: %s [--json FILE] [--quick]\n", argv[0]);
+      return 2;
+    }
+  }
+
+  // 4 KB (L1), 256 KB (L2), 4 MB (L3) and 64 MB (DRAM) of ints
+  std::vector<std::size_t> sizes = { 1u << 10, 1u << 16, 1u << 20, 1u << 24 };
+  if (quick)
+  {
+    sizes.resize(2);
+  }
+
+  std::vector<Row> rows;
+  std::printf("%-24s %-12s %10s %10s %12s\n", "container", "workload", "size", "ns/op", "bytes/op");
+  for (std::size_t n : sizes)
+  {
+    bench<WrapDeque>(n, rows);
+    bench<StdDeque>(n, rows);
+    bench<StdVector>(n, rows);
+#ifdef WRAPBUFFER_BENCH_BOOST
+    bench<BoostRing>(n, rows);
+#endif
+  }
+
+  if (json && !write_json(json, rows))
+  {
+    std::fprintf(stderr, "could not write %s\n", json);
+    return 1;
+  }
+
+  return 0;
+}
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,115 @@
+/*!*****************************************************************************
+*\file     growth_latency_bench.cpp
+*\author   Jalin A. Brown
+*\email    JalinBrownWorks@gmail.com
+
+*\brief Description:
+  Growth cost of Deque, SegmentedDeque and IncrementalDeque while pushing
+  N ints to the back, one at a time:
+
+  1) ns/push: total time over N.
+
+  2) worst push: the slowest single push. For the Deque this is the last
+     reallocation, which copies every element. The SegmentedDeque only ever
+     allocates one block or grows its block map. The IncrementalDeque only
+     allocates the larger array and moves two elements per push; what is
+     left is mostly the allocator unmapping the drained array.
+
+  The containers compared are the template arguments of table() in main().
+
+  Build and run from the repository root:
+    g++ -O2 -std=c++17 -I. bench/growth_latency_bench.cpp -o growth_latency_bench
+    ./growth_latency_bench
+
+******************************************************************************/
+
+//-----------------------------------------------------------------------------
+// Includes:
+//-----------------------------------------------------------------------------
+
+#include "deque.h"
+#include "incremental_deque.h"
+#include "segmented_deque.h"
+#include <chrono>
+#include <cstdio>
+
+//-----------------------------------------------------------------------------
+// Private Functions:
+//-----------------------------------------------------------------------------
+
+namespace {
+
+  using Clock = std::chrono::steady_clock;
+
+  struct Result
+  {
+    double ns_per_push; // Average over every push
+    double worst_us;    // Slowest single push
+  };
+
+  //-------------------------------------------------------------------------
+
+  // Push "n" ints to the back of a fresh container, timing each push
+  template <typename Container>
+  Result grow(std::size_t n) 
+  {
+    Container c;
+    Clock::duration worst{};
+    auto start = Clock::now();
+    for (std::size_t i = 0; i < n; ++i) 
+    {
+      auto t0 = Clock::now();
+      c.Push_back(static_cast<int>(i));
+      auto t1 = Clock::now();
+      worst = (t1 - t0 > worst) ? t1 - t0 : worst;
+    }
+    std::chrono::duration<double, std::nano> total = Clock::now() - start;
+    std::chrono::duration<double, std::micro> worst_us = worst;
+    return { total.count() / n, worst_us.count() };
+  }
+
+  //-------------------------------------------------------------------------
+
+  // One row per N, one pair of columns per container
+  template <typename... Containers>
+  void table(const char* const (&names)[sizeof...(Containers)])
+  {
+    std::printf("%12s", "");
+    for (const char* name : names) 
+    {
+      std::printf(" %22s", name);
+    }
+    std::printf("\n%12s", "N");
+    for (std::size_t i = 0; i < sizeof...(Containers); ++i) 
+    {
+      std::printf(" %10s %11s", "ns/push", "worst us");
+    }
+    std::printf("\n");
+
+    for (std::size_t n : { 1u << 16, 1u << 20, 1u << 24, 1u << 26 }) 
+    {
+      // Braced initialization runs the containers left to right.
+      Result results[] = { grow<Containers>(n)... };
+      std::printf("%12zu", n);
+      for (const Result& r : results) 
+      {
+        std::printf(" %10.2f %11.1f", r.ns_per_push, r.worst_us);
+      }
+      std::printf("\n");
+    }
+  }
+
+}
+
+//-----------------------------------------------------------------------------
+// Public Functions:
+//-----------------------------------------------------------------------------
+
+int main() 
+{
+  table<WrapBuffer::Deque<int>, WrapBuffer::SegmentedDeque<int>, WrapBuffer::IncrementalDeque<int>>(
+    { "Deque", "SegmentedDeque", "IncrementalDeque" });
+  return 0;
+}
+
+//-----------------------------------------------------------------------------
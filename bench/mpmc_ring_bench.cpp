@@ -0,0 +1,147 @@
+/*!*****************************************************************************
+*\file     mpmc_ring_bench.cpp
+*\author   Jalin A. Brown
+*\email    JalinBrownWorks@gmail.com
+
+*\brief Description:
+  Contention benchmark for WrapBuffer::MpmcRing against a WrapBuffer::Deque
+  guarded by a std::mutex.
+
+  For each thread count from 1 to 64, every thread repeatedly pushes a value
+  and then pops one, so all threads act as both producers and consumers and
+  fight over both ends of the queue. Throughput is reported as millions of
+  push+pop pairs per second across all threads.
+
+  Build and run from the repository root:
+    g++ -O2 -std=c++17 -pthread -I. bench/mpmc_ring_bench.cpp -o mpmc_ring_bench
+    ./mpmc_ring_bench
+
+******************************************************************************/
+
+//-----------------------------------------------------------------------------
+// Includes:
+//-----------------------------------------------------------------------------
+
+#include "deque.h"
+#include "mpmc_ring.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//-----------------------------------------------------------------------------
+// Private Functions:
+//-----------------------------------------------------------------------------
+
+namespace {
+
+  using Clock = std::chrono::steady_clock;
+
+  // The mutex-guarded Deque the ring replaces
+  class LockedDeque
+  {
+  public:
+    bool try_push(int val) 
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      d.Push_back(val);
+      return true;
+    }
+
+    bool try_pop(int& out) 
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (d.Empty()) 
+      {
+        return false;
+      }
+      out = d.Pop_front();
+      return true;
+    }
+
+  private:
+    std::mutex mutex;
+    WrapBuffer::Deque<int> d;
+  };
+
+  //-------------------------------------------------------------------------
+
+  // Millions of push+pop pairs per second with "threads" threads
+  template <typename Q>
+  double run(Q& q, unsigned threads, std::size_t pairs_per_thread) 
+  {
+    std::atomic<unsigned> ready(0);
+    std::atomic<bool> go(false);
+    std::vector<std::thread> pool;
+
+    for (unsigned t = 0; t < threads; ++t) 
+    {
+      pool.emplace_back([&, t] 
+      {
+        ready++;
+        while (!go.load(std::memory_order_acquire)) 
+        {
+          std::this_thread::yield();
+        }
+
+        int out = 0;
+        for (std::size_t i = 0; i < pairs_per_thread; ++i) 
+        {
+          while (!q.try_push(static_cast<int>(t))) 
+          {
+            std::this_thread::yield();
+          }
+          while (!q.try_pop(out)) 
+          {
+            std::this_thread::yield();
+          }
+        }
+      });
+    }
+
+    while (ready.load() != threads) 
+    {
+      std::this_thread::yield();
+    }
+    auto start = Clock::now();
+    go.store(true, std::memory_order_release);
+    for (std::thread& th : pool) 
+    {
+      th.join();
+    }
+    std::chrono::duration<double> elapsed = Clock::now() - start;
+
+    return threads * pairs_per_thread / elapsed.count() / 1e6;
+  }
+
+}
+
+//-----------------------------------------------------------------------------
+// Public Functions:
+//-----------------------------------------------------------------------------
+
+int main() 
+{
+  const std::size_t total_pairs = 4000000;
+  const unsigned counts[] = { 1, 2, 4, 8, 16, 32, 64 };
+
+  std::printf("%-8s %16s %16s\n", "threads", "mutex Mops/s", "mpmc Mops/s");
+  for (unsigned threads : counts) 
+  {
+    std::size_t per_thread = total_pairs / threads;
+
+    LockedDeque locked;
+    double m = run(locked, threads, per_thread);
+
+    WrapBuffer::MpmcRing<int> ring(1024);
+    double r = run(ring, threads, per_thread);
+
+    std::printf("%-8u %16.2f %16.2f\n", threads, m, r);
+  }
+
+  return 0;
+}
+
+//-----------------------------------------------------------------------------
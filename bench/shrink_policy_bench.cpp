@@ -0,0 +1,133 @@
+/*!*****************************************************************************
+*\file     shrink_policy_bench.cpp
+*\author   Jalin A. Brown
+*\email    JalinBrownWorks@gmail.com
+
+*\brief Description:
+  Reproduces grow/shrink thrashing in WrapBuffer::Deque and shows what each
+  ShrinkPolicy does about it.
+
+  A Deque of capacity 4S is halved when it drains to S elements, and doubled
+  again as soon as it refills past 2S. A queue whose size swings between
+  S - 1 and 2S + 1 therefore copies its whole buffer twice per swing. The same
+  swing is replayed under:
+
+  1) default:   halve at a quarter full (the original behaviour).
+  2) factor 8:  halve at an eighth full, a wider hysteresis band.
+  3) floor:     never shrink below 4S slots.
+  4) never:     no automatic shrinking, shrink_to_fit() on demand.
+
+  Reallocations are counted by watching Capacity() change, and the bytes
+  copied are the elements moved by each of them.
+
+  Build and run from the repository root:
+    g++ -O2 -std=c++17 -I. bench/shrink_policy_bench.cpp -o shrink_policy_bench
+    ./shrink_policy_bench
+
+******************************************************************************/
+
+//-----------------------------------------------------------------------------
+// Includes:
+//-----------------------------------------------------------------------------
+
+#include "deque.h"
+#include <chrono>
+#include <cstdio>
+
+//-----------------------------------------------------------------------------
+// Private Functions:
+//-----------------------------------------------------------------------------
+
+namespace {
+
+  using Clock = std::chrono::steady_clock;
+
+  struct Result
+  {
+    double ms;                  // Wall time of the whole run
+    std::size_t reallocations;  // Capacity changes observed
+    std::size_t bytes_copied;   // Bytes moved by those reallocations
+  };
+
+  //-------------------------------------------------------------------------
+
+  // Swing a queue between low - 1 and 2 * low + 1 elements "swings" times
+  Result oscillate(const WrapBuffer::ShrinkPolicy& policy, std::size_t low, std::size_t swings) 
+  {
+    WrapBuffer::Deque<int> d(policy);
+    for (std::size_t i = 0; i < low; ++i) 
+    {
+      d.Push_back(static_cast<int>(i));
+    }
+
+    Result result = { 0.0, 0, 0 };
+    std::size_t capacity = d.Capacity();
+    auto track = [&](std::size_t moved) 
+    {
+      if (d.Capacity() != capacity) 
+      {
+        capacity = d.Capacity();
+        result.reallocations++;
+        result.bytes_copied += moved * sizeof(int);
+      }
+    };
+
+    auto start = Clock::now();
+    for (std::size_t s = 0; s < swings; ++s) 
+    {
+      while (d.Size() <= 2 * low) 
+      {
+        std::size_t before = d.Size();
+        d.Push_back(static_cast<int>(s));
+        track(before);
+      }
+      while (d.Size() >= low) 
+      {
+        std::size_t before = d.Size();
+        d.Pop_front();
+        track(before);
+      }
+    }
+    std::chrono::duration<double, std::milli> elapsed = Clock::now() - start;
+    result.ms = elapsed.count();
+    return result;
+  }
+
+}
+
+//-----------------------------------------------------------------------------
+// Public Functions:
+//-----------------------------------------------------------------------------
+
+int main() 
+{
+  const std::size_t low = 1 << 16;
+  const std::size_t swings = 200;
+
+  WrapBuffer::ShrinkPolicy quarter;
+
+  WrapBuffer::ShrinkPolicy eighth;
+  eighth.shrink_factor = 8;
+
+  WrapBuffer::ShrinkPolicy floor;
+  floor.min_capacity = 4 * low;
+
+  WrapBuffer::ShrinkPolicy never;
+  never.automatic = false;
+
+  struct { const char* name; WrapBuffer::ShrinkPolicy policy; } runs[] = {
+    { "default", quarter }, { "factor 8", eighth }, { "floor", floor }, { "never", never },
+  };
+
+  std::printf("swinging between %zu and %zu elements, %zu times\n", low - 1, 2 * low + 1, swings);
+  std::printf("%-10s %10s %14s %16s\n", "policy", "ms", "reallocations", "MB copied");
+  for (const auto& run : runs) 
+  {
+    Result r = oscillate(run.policy, low, swings);
+    std::printf("%-10s %10.2f %14zu %16.1f\n", run.name, r.ms, r.reallocations, r.bytes_copied / 1048576.0);
+  }
+
+  return 0;
+}
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,138 @@
+/*!*****************************************************************************
+*\file     sliding_window_bench.cpp
+*\author   Jalin A. Brown
+*\email    JalinBrownWorks@gmail.com
+
+*\brief Description:
+  Cost per tick of tracking the min and max of a rolling window of samples:
+
+  1) scan: the window is a Deque of the last W samples, and every tick
+     pushes the new sample, pops the oldest and scans the window with
+     operator[] for the min and max.
+
+  2) extrema: SlidingWindowExtrema, push(value) and expire_older_than(W)
+     followed by min() and max().
+
+  The samples are a random walk, like a price series, so the extremes move
+  around instead of sitting at one end of the window.
+
+  Build and run from the repository root:
+    g++ -O2 -std=c++17 -I. bench/sliding_window_bench.cpp -o sliding_window_bench
+    ./sliding_window_bench
+
+******************************************************************************/
+
+//-----------------------------------------------------------------------------
+// Includes:
+//-----------------------------------------------------------------------------
+
+#include "deque.h"
+#include "sliding_window_extrema.h"
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+//-----------------------------------------------------------------------------
+// Private Functions:
+//-----------------------------------------------------------------------------
+
+namespace {
+
+  using Clock = std::chrono::steady_clock;
+
+  // Keep the optimizer from discarding a computed value
+  template <typename T>
+  void keep(const T& value) 
+  {
+    asm volatile("" : : "g"(&value) : "memory");
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Random walk of "n" samples
+  std::vector<double> random_walk(std::size_t n) 
+  {
+    std::vector<double> samples(n);
+    std::uint64_t x = 88172645463325252ull;
+    double price = 100.0;
+    for (double& s : samples) 
+    {
+      x ^= x << 13;
+      x ^= x >> 7;
+      x ^= x << 17;
+      price += static_cast<double>(x % 2001) / 1000.0 - 1.0;
+      s = price;
+    }
+    return samples;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Nanoseconds per tick, rescanning the window with operator[]
+  double scan(const std::vector<double>& samples, std::size_t window) 
+  {
+    WrapBuffer::Deque<double> d;
+    auto start = Clock::now();
+    for (double s : samples) 
+    {
+      d.Push_back(s);
+      if (d.Size() > window) 
+      {
+        d.Pop_front();
+      }
+
+      double lo = d[0];
+      double hi = d[0];
+      for (std::size_t i = 1; i < d.Size(); ++i) 
+      {
+        lo = (d[i] < lo) ? d[i] : lo;
+        hi = (d[i] > hi) ? d[i] : hi;
+      }
+      keep(lo);
+      keep(hi);
+    }
+    std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+    return elapsed.count() / samples.size();
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Nanoseconds per tick with SlidingWindowExtrema
+  double extrema(const std::vector<double>& samples, std::size_t window) 
+  {
+    WrapBuffer::SlidingWindowExtrema<double> w;
+    auto start = Clock::now();
+    for (double s : samples) 
+    {
+      w.push(s);
+      w.expire_older_than(window);
+      keep(w.min());
+      keep(w.max());
+    }
+    std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+    return elapsed.count() / samples.size();
+  }
+
+}
+
+//-----------------------------------------------------------------------------
+// Public Functions:
+//-----------------------------------------------------------------------------
+
+int main() 
+{
+  const std::size_t ticks = 1u << 20;
+  std::vector<double> samples = random_walk(ticks);
+
+  std::printf("%8s %14s %16s %10s\n", "window", "scan ns/tick", "extrema ns/tick", "speedup");
+  for (std::size_t window : { 16u, 64u, 256u, 1024u, 4096u }) 
+  {
+    double s = scan(samples, window);
+    double e = extrema(samples, window);
+    std::printf("%8zu %14.2f %16.2f %9.1fx\n", window, s, e, s / e);
+  }
+  return 0;
+}
+
+//-----------------------------------------------------------------------------
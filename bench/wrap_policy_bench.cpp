@@ -0,0 +1,130 @@
+/*!*****************************************************************************
+*\file     wrap_policy_bench.cpp
+*\author   Jalin A. Brown
+*\email    JalinBrownWorks@gmail.com
+
+*\brief Description:
+  Compares the ModuloWrap and PowerOfTwoWrap policies of WrapBuffer::Deque on
+  the paths that wrap an index on every call:
+
+  1) FIFO push/pop: Push_back followed by Pop_front on a queue held at a
+     steady size, so "b" and "e" keep wrapping around the array.
+
+  2) Indexed read: summing every element through operator[].
+
+  The modulo Deque is seeded from an array so its capacity is not a power of
+  two, which is the case the division cannot be strength-reduced away.
+
+  Build and run from the repository root:
+    g++ -O2 -std=c++17 -I. bench/wrap_policy_bench.cpp -o wrap_policy_bench
+    ./wrap_policy_bench
+
+******************************************************************************/
+
+//-----------------------------------------------------------------------------
+// Includes:
+//-----------------------------------------------------------------------------
+
+#include "deque.h"
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+//-----------------------------------------------------------------------------
+// Private Functions:
+//-----------------------------------------------------------------------------
+
+namespace {
+
+  using Clock = std::chrono::steady_clock;
+
+  // Keep the optimizer from discarding a computed value
+  template <typename T>
+  void keep(const T& value) 
+  {
+    asm volatile("" : : "g"(&value) : "memory");
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Nanoseconds per FIFO push/pop pair on a queue of "n" elements
+  template <typename D>
+  double fifo(std::size_t n, std::size_t ops) 
+  {
+    std::vector<int> seed(n, 1);
+    D d(seed.data(), n);
+
+    // Leave one slot free so Push_back never reallocates.
+    d.Pop_front();
+
+    auto start = Clock::now();
+    for (std::size_t i = 0; i < ops; ++i) 
+    {
+      d.Push_back(static_cast<int>(i));
+      keep(d.Pop_front());
+    }
+    std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+    return elapsed.count() / ops;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Nanoseconds per operator[] read over a queue of "n" elements
+  template <typename D>
+  double indexed(std::size_t n, std::size_t ops) 
+  {
+    std::vector<int> seed(n, 1);
+    D d(seed.data(), n);
+
+    // Rotate so the live range straddles the end of the array.
+    for (std::size_t i = 0; i < n / 2; ++i) 
+    {
+      d.Push_back(d.Pop_front());
+    }
+
+    long long sum = 0;
+    std::size_t reads = 0;
+    auto start = Clock::now();
+    while (reads < ops) 
+    {
+      for (std::size_t i = 0; i < d.Size(); ++i) 
+      {
+        sum += d[i];
+      }
+      reads += d.Size();
+    }
+    std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+    keep(sum);
+    return elapsed.count() / reads;
+  }
+
+}
+
+//-----------------------------------------------------------------------------
+// Public Functions:
+//-----------------------------------------------------------------------------
+
+int main() 
+{
+  using ModuloDeque = WrapBuffer::Deque<int>;
+  using MaskDeque   = WrapBuffer::Deque<int, std::allocator<int>, WrapBuffer::PowerOfTwoWrap>;
+
+  const std::size_t ops = 50000000;
+  const std::size_t sizes[] = { 1000, 100000, 10000000 };
+
+  std::printf("%-10s %-12s %12s %12s %9s\n", "size", "workload", "modulo ns", "mask ns", "speedup");
+  for (std::size_t n : sizes) 
+  {
+    double m = fifo<ModuloDeque>(n, ops);
+    double p = fifo<MaskDeque>(n, ops);
+    std::printf("%-10zu %-12s %12.3f %12.3f %8.2fx\n", n, "push/pop", m, p, m / p);
+
+    m = indexed<ModuloDeque>(n, ops);
+    p = indexed<MaskDeque>(n, ops);
+    std::printf("%-10zu %-12s %12.3f %12.3f %8.2fx\n", n, "operator[]", m, p, m / p);
+  }
+
+  return 0;
+}
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,641 @@
+/*!*****************************************************************************
+*\file     cow_deque.h
+*\author   Jalin A. Brown
+*\email    JalinBrownWorks@gmail.com
+
+*\brief Description:
+  Copy-on-write handle over a Deque, for code that copies deques mostly to
+  read them (snapshots for monitoring, history, undo).
+
+  A CowDeque holds a reference-counted Deque. Copying the handle only bumps
+  the count, so a snapshot of a million-element queue costs the same as a
+  snapshot of an empty one:
+
+    CowDeque<int> live;
+    CowDeque<int> snapshot = live;  // O(1), both share one array
+    live.Push_back(1);              // live gets a private copy first
+
+  1) Reads (Size, operator[], the iterators, for_each) go straight to the
+     shared Deque and never copy.
+
+  2) Every write first calls unshare(). If another handle still refers to
+     the Deque, the elements are copied into a Deque of this handle's own,
+     once, and the write goes there. A handle that is the only owner writes
+     in place with no copy at all.
+
+  3) Each handle also keeps its own orientation on top of the shared Deque,
+     the same way Deque::reverse() does, so reverse() and operator~ are O(1)
+     and do not copy either. The orientation is folded into the private
+     Deque the next time the handle writes.
+
+  Only the small Deque header and the count live on the heap, the elements
+  come from the Allocator as usual.
+
+  Handles that share a Deque may be used from different threads, because
+  the shared Deque is only ever read. One handle is not thread-safe, like
+  any other container.
+
+******************************************************************************/
+
+#ifndef WRAPBUFFER_COW_DEQUE_H
+#define WRAPBUFFER_COW_DEQUE_H
+
+//-----------------------------------------------------------------------------
+// Includes:
+//-----------------------------------------------------------------------------
+
+#include "deque.h"
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <ostream>
+#include <utility>
+
+//-----------------------------------------------------------------------------
+// Public Structures:
+//-----------------------------------------------------------------------------
+
+namespace WrapBuffer {
+
+  template <typename T, typename Allocator = std::allocator<T>, typename Wrap = ModuloWrap>
+  class CowDeque
+  {
+    class basic_const_iterator;
+
+  public:
+    using deque_type             = Deque<T, Allocator, Wrap>;
+    using value_type             = T;
+    using allocator_type         = Allocator;
+    using size_type              = std::size_t;
+    using difference_type        = std::ptrdiff_t;
+    using const_reference        = const T&;
+    using const_iterator         = basic_const_iterator;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    // Default CTOR
+    CowDeque();
+
+    // Allocator CTOR
+    explicit CowDeque(const Allocator& alloc_);
+
+    // Parameterized CTOR
+    CowDeque(const T* array_, size_type size_, const Allocator& alloc_ = Allocator());
+
+    // Copy the elements of a Deque into a new, unshared CowDeque
+    explicit CowDeque(const deque_type& rhs);
+
+    // Copy CTOR and Assignment, O(1): the Deque is shared, not copied
+    CowDeque(const CowDeque& rhs) = default;
+    CowDeque& operator=(const CowDeque& rhs) = default;
+
+    // Move CTOR and Move Assignment, O(1): the Deque changes handles and its
+    // count does not go up. A moved-from CowDeque holds no Deque and may
+    // only be assigned to or destroyed.
+    CowDeque(CowDeque&& rhs) noexcept = default;
+    CowDeque& operator=(CowDeque&& rhs) noexcept = default;
+
+    // Get the size of the CowDeque
+    size_type Size() const;
+
+    // Check if the CowDeque is empty
+    bool Empty() const;
+
+    // Get the capacity of the underlying Deque
+    size_type Capacity() const;
+
+    // Get the allocator of the underlying Deque
+    Allocator get_allocator() const;
+
+    // Whether another CowDeque currently shares this one's Deque
+    bool is_shared() const;
+
+    // Read an element, never copies
+    const T& operator[](size_type pos) const;
+
+    // Writable reference to an element, unsharing first
+    T& modify(size_type pos);
+
+    // Clear the CowDeque, a shared Deque is dropped instead of copied
+    void Clear();
+
+    // Push a value to the back or front of the CowDeque
+    void Push_back(const T& val);
+    void Push_back(T&& val);
+    void Push_front(const T& val);
+    void Push_front(T&& val);
+
+    // Construct a value in place at the back or front of the CowDeque
+    template <typename... Args>
+    T& emplace_back(Args&&... args);
+    template <typename... Args>
+    T& emplace_front(Args&&... args);
+
+    // Pop the value from the back or front of the CowDeque, T() when empty
+    T Pop_back();
+    T Pop_front();
+
+    // Bulk pushes and pops, see Deque
+    void push_back_n(const T* src, size_type count);
+    void push_front_n(const T* src, size_type count);
+    size_type pop_front_n(T* out, size_type count);
+    size_type pop_back_n(T* out, size_type count);
+
+    // Addition and assignment operator +=, copies a shared Deque at most once
+    CowDeque& operator+=(const CowDeque& rhs);
+
+    // Addition Operator +, builds the result with a single allocation
+    CowDeque operator+(const CowDeque& rhs) const;
+
+    // Reverse the values of the CowDeque, O(1) and never copies
+    CowDeque& reverse();
+
+    // Copy, Flip, and Return a CowDeque, O(1): shares the Deque
+    CowDeque operator~() const;
+
+    // Iterators over the elements from front to back, read-only
+    const_iterator begin() const { return const_iterator(data->cbegin(), 0, data->Size(), reversed); }
+    const_iterator end() const { return const_iterator(data->cbegin(), data->Size(), data->Size(), reversed); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+    const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+    const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+    // Call f(element) on every element, front to back
+    template <typename F>
+    void for_each(F f) const;
+
+  private:
+    using alloc_traits = std::allocator_traits<Allocator>;
+
+    // Make the Deque private to this handle and fold the handle's orientation
+    // into it. A copy gets room for "extra" more elements.
+    deque_type& unshare(size_type extra = 0);
+
+    // Random-access iterator, maps a logical position through the orientation
+    class basic_const_iterator
+    {
+      friend class CowDeque;
+      using base_iterator = typename deque_type::const_iterator;
+
+    public:
+      using iterator_category = std::random_access_iterator_tag;
+      using value_type        = T;
+      using difference_type   = std::ptrdiff_t;
+      using pointer           = const T*;
+      using reference         = const T&;
+
+      basic_const_iterator() : first(), pos(0), size(0), flipped(false) {}
+
+      reference operator*() const { return first[flipped ? size - 1 - pos : pos]; }
+      pointer operator->() const { return &**this; }
+      reference operator[](difference_type n) const { return *(*this + n); }
+
+      basic_const_iterator& operator++() { ++pos; return *this; }
+      basic_const_iterator& operator--() { --pos; return *this; }
+      basic_const_iterator operator++(int) { basic_const_iterator old(*this); ++pos; return old; }
+      basic_const_iterator operator--(int) { basic_const_iterator old(*this); --pos; return old; }
+      basic_const_iterator& operator+=(difference_type n) { pos += n; return *this; }
+      basic_const_iterator& operator-=(difference_type n) { pos -= n; return *this; }
+
+      friend basic_const_iterator operator+(basic_const_iterator it, difference_type n) { return it += n; }
+      friend basic_const_iterator operator+(difference_type n, basic_const_iterator it) { return it += n; }
+      friend basic_const_iterator operator-(basic_const_iterator it, difference_type n) { return it -= n; }
+      friend difference_type operator-(const basic_const_iterator& l, const basic_const_iterator& r) { return l.pos - r.pos; }
+
+      friend bool operator==(const basic_const_iterator& l, const basic_const_iterator& r) { return l.pos == r.pos; }
+      friend bool operator!=(const basic_const_iterator& l, const basic_const_iterator& r) { return l.pos != r.pos; }
+      friend bool operator<(const basic_const_iterator& l, const basic_const_iterator& r) { return l.pos < r.pos; }
+      friend bool operator>(const basic_const_iterator& l, const basic_const_iterator& r) { return l.pos > r.pos; }
+      friend bool operator<=(const basic_const_iterator& l, const basic_const_iterator& r) { return l.pos <= r.pos; }
+      friend bool operator>=(const basic_const_iterator& l, const basic_const_iterator& r) { return l.pos >= r.pos; }
+
+    private:
+      basic_const_iterator(base_iterator first_, size_type pos_, size_type size_, bool flipped_)
+        : first(first_), pos(static_cast<difference_type>(pos_)), size(static_cast<difference_type>(size_)), flipped(flipped_) {}
+
+      base_iterator first;  // Front of the shared Deque
+      difference_type pos;  // Logical index, 0 is the front
+      difference_type size; // Number of elements
+      bool flipped;         // Whether the handle was reversed
+    };
+
+    std::shared_ptr<deque_type> data; // Deque, possibly shared with other handles
+    bool reversed;                    // Whether this handle sees the Deque back to front
+  };
+
+  // Write the elements as text, "format" picks the separators (text_io.h)
+  template <typename T, typename Allocator, typename Wrap>
+  std::ostream& write_text(std::ostream& os, const CowDeque<T, Allocator, Wrap>& d, const TextFormat& format = TextFormat());
+
+  // Stream Operator Overload
+  template <typename T, typename Allocator, typename Wrap>
+  std::ostream& operator<<(std::ostream& os, const CowDeque<T, Allocator, Wrap>& d);
+
+  //-----------------------------------------------------------------------------
+  // Public Functions:
+  //-----------------------------------------------------------------------------
+
+  // Default CTOR
+  template <typename T, typename Allocator, typename Wrap>
+  CowDeque<T, Allocator, Wrap>::CowDeque() : CowDeque(Allocator()) {}
+
+  //-------------------------------------------------------------------------
+
+  // Allocator CTOR
+  template <typename T, typename Allocator, typename Wrap>
+  CowDeque<T, Allocator, Wrap>::CowDeque(const Allocator& alloc_)
+    : data(std::make_shared<deque_type>(alloc_)), reversed(false) {}
+
+  //-------------------------------------------------------------------------
+
+  // Parameterized CTOR
+  template <typename T, typename Allocator, typename Wrap>
+  CowDeque<T, Allocator, Wrap>::CowDeque(const T* array_, size_type size_, const Allocator& alloc_)
+    : data(std::make_shared<deque_type>(array_, size_, alloc_)), reversed(false) {}
+
+  //-------------------------------------------------------------------------
+
+  // Copy the elements of a Deque into a new, unshared CowDeque
+  template <typename T, typename Allocator, typename Wrap>
+  CowDeque<T, Allocator, Wrap>::CowDeque(const deque_type& rhs)
+    : data(std::make_shared<deque_type>(rhs)), reversed(false) {}
+
+  //-------------------------------------------------------------------------
+
+  // Get the size of the CowDeque
+  template <typename T, typename Allocator, typename Wrap>
+  typename CowDeque<T, Allocator, Wrap>::size_type CowDeque<T, Allocator, Wrap>::Size() const
+  {
+    return data->Size();
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Check if the CowDeque is empty
+  template <typename T, typename Allocator, typename Wrap>
+  bool CowDeque<T, Allocator, Wrap>::Empty() const
+  {
+    return data->Empty();
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Get the capacity of the underlying Deque
+  template <typename T, typename Allocator, typename Wrap>
+  typename CowDeque<T, Allocator, Wrap>::size_type CowDeque<T, Allocator, Wrap>::Capacity() const
+  {
+    return data->Capacity();
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Get the allocator of the underlying Deque
+  template <typename T, typename Allocator, typename Wrap>
+  Allocator CowDeque<T, Allocator, Wrap>::get_allocator() const
+  {
+    return data->get_allocator();
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Whether another CowDeque currently shares this one's Deque
+  template <typename T, typename Allocator, typename Wrap>
+  bool CowDeque<T, Allocator, Wrap>::is_shared() const
+  {
+    return data.use_count() > 1;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Read an element, never copies
+  template <typename T, typename Allocator, typename Wrap>
+  const T& CowDeque<T, Allocator, Wrap>::operator[](size_type pos) const
+  {
+    const deque_type& d = *data;
+    if (pos >= d.Size())
+    {
+      throw std::out_of_range("Index out of range");
+    }
+    return d[reversed ? d.Size() - 1 - pos : pos];
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Writable reference to an element, unsharing first
+  template <typename T, typename Allocator, typename Wrap>
+  T& CowDeque<T, Allocator, Wrap>::modify(size_type pos)
+  {
+    if (pos >= Size())
+    {
+      throw std::out_of_range("Index out of range");
+    }
+    return unshare()[pos];
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Clear the CowDeque, a shared Deque is dropped instead of copied
+  template <typename T, typename Allocator, typename Wrap>
+  void CowDeque<T, Allocator, Wrap>::Clear()
+  {
+    if (is_shared())
+    {
+      Allocator alloc = alloc_traits::select_on_container_copy_construction(data->get_allocator());
+      auto fresh = std::make_shared<deque_type>(data->shrink_policy(), alloc);
+      data = std::move(fresh);
+    }
+    else
+    {
+      data->Clear();
+    }
+    reversed = false;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Push a value to the back of the CowDeque
+  template <typename T, typename Allocator, typename Wrap>
+  void CowDeque<T, Allocator, Wrap>::Push_back(const T& val)
+  {
+    emplace_back(val);
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Push a value to the back of the CowDeque
+  template <typename T, typename Allocator, typename Wrap>
+  void CowDeque<T, Allocator, Wrap>::Push_back(T&& val)
+  {
+    emplace_back(std::move(val));
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Push a value to the front of the CowDeque
+  template <typename T, typename Allocator, typename Wrap>
+  void CowDeque<T, Allocator, Wrap>::Push_front(const T& val)
+  {
+    emplace_front(val);
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Push a value to the front of the CowDeque
+  template <typename T, typename Allocator, typename Wrap>
+  void CowDeque<T, Allocator, Wrap>::Push_front(T&& val)
+  {
+    emplace_front(std::move(val));
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Construct a value in place at the back of the CowDeque
+  template <typename T, typename Allocator, typename Wrap>
+  template <typename... Args>
+  T& CowDeque<T, Allocator, Wrap>::emplace_back(Args&&... args)
+  {
+    // The arguments may refer to the shared Deque, which stays alive while
+    // another handle holds it, so they are still valid after unshare().
+    return unshare(1).emplace_back(std::forward<Args>(args)...);
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Construct a value in place at the front of the CowDeque
+  template <typename T, typename Allocator, typename Wrap>
+  template <typename... Args>
+  T& CowDeque<T, Allocator, Wrap>::emplace_front(Args&&... args)
+  {
+    return unshare(1).emplace_front(std::forward<Args>(args)...);
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Pop the value from the back of the CowDeque
+  template <typename T, typename Allocator, typename Wrap>
+  T CowDeque<T, Allocator, Wrap>::Pop_back()
+  {
+    if (Empty())
+    {
+      return T();
+    }
+    return unshare().Pop_back();
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Pop the value from the front of the CowDeque
+  template <typename T, typename Allocator, typename Wrap>
+  T CowDeque<T, Allocator, Wrap>::Pop_front()
+  {
+    if (Empty())
+    {
+      return T();
+    }
+    return unshare().Pop_front();
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Push "count" values to the back of the CowDeque, src[0] first
+  template <typename T, typename Allocator, typename Wrap>
+  void CowDeque<T, Allocator, Wrap>::push_back_n(const T* src, size_type count)
+  {
+    if (count)
+    {
+      unshare(count).push_back_n(src, count);
+    }
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Push "count" values to the front of the CowDeque, keeping their order
+  template <typename T, typename Allocator, typename Wrap>
+  void CowDeque<T, Allocator, Wrap>::push_front_n(const T* src, size_type count)
+  {
+    if (count)
+    {
+      unshare(count).push_front_n(src, count);
+    }
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Pop up to "count" values from the front into out, returns how many
+  template <typename T, typename Allocator, typename Wrap>
+  typename CowDeque<T, Allocator, Wrap>::size_type CowDeque<T, Allocator, Wrap>::pop_front_n(T* out, size_type count)
+  {
+    if (count == 0 || Empty())
+    {
+      return 0;
+    }
+    return unshare().pop_front_n(out, count);
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Pop up to "count" values from the back into out, returns how many
+  template <typename T, typename Allocator, typename Wrap>
+  typename CowDeque<T, Allocator, Wrap>::size_type CowDeque<T, Allocator, Wrap>::pop_back_n(T* out, size_type count)
+  {
+    if (count == 0 || Empty())
+    {
+      return 0;
+    }
+    return unshare().pop_back_n(out, count);
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Addition and assignment operator +=
+  template <typename T, typename Allocator, typename Wrap>
+  CowDeque<T, Allocator, Wrap>& CowDeque<T, Allocator, Wrap>::operator+=(const CowDeque& rhs)
+  {
+    if (rhs.Empty())
+    {
+      return *this;
+    }
+
+    if (&rhs == this)
+    {
+      // Both sides see the same orientation once it is folded in.
+      deque_type& d = unshare(Size());
+      d += d;
+      return *this;
+    }
+
+    // Keep rhs's Deque alive, unshare() may drop this handle's reference
+    // to it when the two share one.
+    std::shared_ptr<deque_type> other = rhs.data;
+    bool other_reversed = rhs.reversed;
+
+    deque_type& d = unshare(other->Size());
+    if (other_reversed)
+    {
+      for (auto it = other->cend(); it != other->cbegin();)
+      {
+        d.emplace_back(*--it);
+      }
+    }
+    else
+    {
+      d += *other;
+    }
+    return *this;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Addition Operator +
+  template <typename T, typename Allocator, typename Wrap>
+  CowDeque<T, Allocator, Wrap> CowDeque<T, Allocator, Wrap>::operator+(const CowDeque& rhs) const
+  {
+    // Starts out sharing *this, so unshare() copies it once into an array
+    // already big enough for rhs.
+    CowDeque result(*this);
+    result += rhs;
+    return result;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Reverse the values of the CowDeque, O(1) and never copies
+  template <typename T, typename Allocator, typename Wrap>
+  CowDeque<T, Allocator, Wrap>& CowDeque<T, Allocator, Wrap>::reverse()
+  {
+    reversed = !reversed;
+    return *this;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Copy, Flip, and Return a CowDeque
+  template <typename T, typename Allocator, typename Wrap>
+  CowDeque<T, Allocator, Wrap> CowDeque<T, Allocator, Wrap>::operator~() const
+  {
+    CowDeque flipped(*this);
+    flipped.reversed = !reversed;
+    return flipped;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Call f(element) on every element, front to back
+  template <typename T, typename Allocator, typename Wrap>
+  template <typename F>
+  void CowDeque<T, Allocator, Wrap>::for_each(F f) const
+  {
+    const deque_type& d = *data;
+    if (reversed)
+    {
+      for (auto it = d.cend(); it != d.cbegin();)
+      {
+        f(*--it);
+      }
+      return;
+    }
+    d.for_each(f);
+  }
+
+  //-------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// Private Functions:
+//-----------------------------------------------------------------------------
+
+  // Make the Deque private to this handle, a copy gets room for "extra" more elements
+  template <typename T, typename Allocator, typename Wrap>
+  typename CowDeque<T, Allocator, Wrap>::deque_type& CowDeque<T, Allocator, Wrap>::unshare(size_type extra)
+  {
+    if (data.use_count() > 1)
+    {
+      // Copy once, straight into an array with room for what is coming.
+      Allocator alloc = alloc_traits::select_on_container_copy_construction(data->get_allocator());
+      auto fresh = std::make_shared<deque_type>(data->shrink_policy(), alloc);
+      fresh->reserve(data->Size() + extra);
+      *fresh += *data;
+      data = std::move(fresh);
+    }
+    else
+    {
+      // The other handles may have just let go from other threads, and
+      // their reads must be finished before this one writes.
+      std::atomic_thread_fence(std::memory_order_acquire);
+    }
+
+    if (reversed)
+    {
+      // O(1) on the Deque as well, it reverses lazily.
+      data->reverse();
+      reversed = false;
+    }
+    return *data;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Write the elements as text
+  template <typename T, typename Allocator, typename Wrap>
+  std::ostream& write_text(std::ostream& os, const CowDeque<T, Allocator, Wrap>& d, const TextFormat& format)
+  {
+    return detail::write_elements(os, d, format);
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Stream Operator Overload
+  template <typename T, typename Allocator, typename Wrap>
+  std::ostream& operator<<(std::ostream& os, const CowDeque<T, Allocator, Wrap>& d)
+  {
+    // Prints the elements followed by spaces.
+    return write_text(os, d);
+  }
+
+  //-------------------------------------------------------------------------
+
+}
+
+#endif // WRAPBUFFER_COW_DEQUE_H
+
+//-----------------------------------------------------------------------------
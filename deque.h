@@ -0,0 +1,492 @@
+/*!*****************************************************************************
+*\file     deque.h
+*\author   Jalin A. Brown
+*\email    JalinBrownWorks@gmail.com
+
+*\brief Description:
+  Interface of a circular array - an array that supports efficient insert
+  on both ends.
+
+  The Deque is a class template over the element type and an allocator.
+  Elements are constructed in place inside raw storage obtained from the
+  allocator, moved when the buffer is reallocated and destroyed when they are
+  popped or cleared, so move-only and non-trivial types are stored directly.
+
+  How an index is wrapped around the end of the array is a policy. The
+  default ModuloWrap keeps any capacity and wraps with "% capacity". The
+  opt-in PowerOfTwoWrap rounds every capacity up to a power of two so the
+  wrap becomes "& (capacity - 1)", trading some slack memory for removing an
+  integer division from every push, pop and index.
+
+  Elements can be walked two ways. begin()/end() give random-access
+  iterators that wrap on dereference and do no bounds check, so the std::
+  algorithms work on a Deque directly. for_each_segment() hands out the live
+  range as at most two contiguous runs, [b, capacity) then [0, e), so a hot
+  loop over plain pointers can be vectorized by the compiler.
+
+  reverse() is O(1): it flips an orientation flag, and while the flag is set
+  logical position i is the element size - 1 - i of the array. Indexing,
+  iterators and every push and pop map through the flag, so the elements only
+  move when contiguous runs are asked for. normalize(), the non-const
+  for_each_segment() and the bulk operations reverse the array in place
+  first, and the const for_each_segment() hands out one-element runs instead.
+
+  Pops shrink the array according to a ShrinkPolicy. By default the array
+  is halved once it is a quarter full. A larger shrink_factor widens the gap
+  between the grow and shrink points so a queue hovering near one of them
+  stops reallocating on every swing, min_capacity keeps a floor under the
+  array, and turning automatic off leaves shrinking to shrink_to_fit().
+
+  All storage comes from the Allocator, and every constructor has a form
+  that takes one, so deques can live in arenas or pools instead of the
+  global heap. WrapBuffer::pmr::Deque<T> uses std::pmr::polymorphic_allocator
+  and is constructed straight from a std::pmr::memory_resource*. As with the
+  standard containers, a copy assigned into a Deque keeps the target's
+  allocator unless the allocator asks to propagate.
+
+  The last parameter is an instrumentation policy (deque_stats.h). The
+  default NoStats compiles away, and CountingStats counts reallocations,
+  bytes moved, peak size and capacity, wrap-arounds and empty pops for
+  stats() to read from any thread.
+
+  operator<< and operator>> format and parse numbers in bulk with
+  to_chars/from_chars, and write_text()/read_text() take custom
+  separators (text_io.h).
+
+  Deques of trivially copyable types can be saved to and loaded from a
+  binary snapshot, or mapped read-only straight from one (snapshot.h).
+
+  Implementation lives in deque.tpp, which is included at the bottom of this
+  header.
+
+******************************************************************************/
+
+#ifndef WRAPBUFFER_DEQUE_H
+#define WRAPBUFFER_DEQUE_H
+
+//-----------------------------------------------------------------------------
+// Includes:
+//-----------------------------------------------------------------------------
+
+#include "deque_stats.h"
+#include "simd_reverse.h"
+#include "snapshot.h"
+#include "text_io.h"
+#include "wrap_policy.h"
+#include <cstddef>
+#include <iosfwd>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <stdexcept>
+#include <type_traits>
+
+//-----------------------------------------------------------------------------
+// Public Structures:
+//-----------------------------------------------------------------------------
+
+namespace WrapBuffer {
+
+  // When pops give memory back
+  struct ShrinkPolicy
+  {
+    std::size_t min_capacity = 0;  // Never shrink below this many slots
+    std::size_t shrink_factor = 4; // Halve once size <= capacity / shrink_factor, must be > 2
+    bool automatic = true;         // False leaves shrinking to shrink_to_fit()
+  };
+
+  // Unevaluated "lhs + rhs" of Deques, see below
+  template <typename D, typename Lhs, typename Rhs>
+  class DequeConcat;
+
+  template <typename T, typename Allocator = std::allocator<T>, typename Wrap = ModuloWrap, typename Stats = NoStats>
+  class Deque : private Stats
+  {
+    template <bool IsConst>
+    class basic_iterator;
+
+  public:
+    using value_type             = T;
+    using allocator_type         = Allocator;
+    using size_type              = std::size_t;
+    using difference_type        = std::ptrdiff_t;
+    using reference              = T&;
+    using const_reference        = const T&;
+    using iterator               = basic_iterator<false>;
+    using const_iterator         = basic_iterator<true>;
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    // Default CTOR
+    Deque();
+
+    // Allocator CTOR
+    explicit Deque(const Allocator& alloc_);
+
+    // Shrink Policy CTOR
+    explicit Deque(const ShrinkPolicy& policy, const Allocator& alloc_ = Allocator());
+
+    // Parameterized CTOR
+    Deque(const T* array_, size_type size_, const Allocator& alloc_ = Allocator());
+
+    // Copy CTOR
+    Deque(const Deque& rhs);
+
+    // Copy CTOR into storage from a given allocator
+    Deque(const Deque& rhs, const Allocator& alloc_);
+
+    // Move CTOR, takes over rhs's array and leaves rhs empty
+    Deque(Deque&& rhs) noexcept;
+
+    // Assignment Operator
+    Deque& operator=(const Deque& rhs);
+
+    // Move Assignment Operator, only moves element by element when the
+    // allocators neither propagate nor compare equal
+    Deque& operator=(Deque&& rhs) noexcept(alloc_traits::propagate_on_container_move_assignment::value 
+                                        || alloc_traits::is_always_equal::value);
+
+    // DTOR
+    ~Deque();
+
+    // Get the size of the Deque
+    size_type Size() const;
+
+    // Check if the Deque is empty
+    bool Empty() const;
+
+    // Clear the Deque, O(1) for trivially destructible T, keeps the array
+    void Clear();
+
+    // Clear the Deque and free its array
+    void Clear_and_release();
+
+    // Clear the Deque and overwrite every slot of the array with zeros,
+    // including slots left behind by earlier pops. Arrays already given back
+    // by growth or shrinking are not reachable and are not wiped.
+    void Secure_clear();
+
+    // Get the capacity of the Deque
+    size_type Capacity() const;
+
+    // Get the allocator of the Deque
+    Allocator get_allocator() const;
+
+    // Counters kept by the Stats policy, safe to call from another thread
+    DequeStats stats() const;
+
+    // Get or set when pops shrink the array
+    const ShrinkPolicy& shrink_policy() const;
+    void set_shrink_policy(const ShrinkPolicy& policy);
+
+    // Make room for at least "count" elements without further reallocation
+    void reserve(size_type count);
+
+    // Release unused slots, down to the policy's minimum capacity
+    void shrink_to_fit();
+
+    // Push a value to the back of the Deque
+    void Push_back(const T& val);
+    void Push_back(T&& val);
+
+    // Construct a value in place at the back of the Deque
+    template <typename... Args>
+    T& emplace_back(Args&&... args);
+
+    // Pop the value from the back of the Deque. An empty Deque returns T(),
+    // so T must be default constructible; pop_back_n does not need it.
+    T Pop_back();
+
+    // Index Operators
+    T& operator[](size_type pos);
+    const T& operator[](size_type pos) const;
+
+    // Swap two Deques
+    void swap(Deque& other);
+
+    // Push a value to the front of the Deque
+    void Push_front(const T& val);
+    void Push_front(T&& val);
+
+    // Construct a value in place at the front of the Deque
+    template <typename... Args>
+    T& emplace_front(Args&&... args);
+
+    // Pop a value from the front of the Deque. An empty Deque returns T(),
+    // so T must be default constructible; pop_front_n does not need it.
+    T Pop_front();
+
+    // Addition and assignment operator +=
+    Deque& operator+=(const Deque& rhs);
+
+    // Append every operand of a concatenation with at most one reallocation
+    template <typename Lhs, typename Rhs>
+    Deque& operator+=(const DequeConcat<Deque, Lhs, Rhs>& rhs);
+
+    // Addition Operator +, returns a DequeConcat so a whole chain of + is
+    // sized and allocated once, when it is converted to a Deque
+    DequeConcat<Deque, Deque, Deque> operator+(const Deque& rhs) const&;
+    template <typename Lhs, typename Rhs>
+    DequeConcat<Deque, Deque, DequeConcat<Deque, Lhs, Rhs>> operator+(const DequeConcat<Deque, Lhs, Rhs>& rhs) const&;
+
+    // Addition Operator + on a temporary, appends into its array
+    Deque operator+(const Deque& rhs) &&;
+    template <typename Lhs, typename Rhs>
+    Deque operator+(const DequeConcat<Deque, Lhs, Rhs>& rhs) &&;
+
+    // Reverse the values of the Deque, O(1) until contiguous access needs it
+    Deque& reverse();
+
+    // Apply a pending reverse() to the array so runs are front to back again
+    void normalize();
+
+    // Copy, Flip, and Return a Deque array, a temporary is flipped in place
+    Deque operator~() const&;
+    Deque operator~() &&;
+
+    // Bulk pushes, each grows at most once and copies in at most two runs.
+    // src must not point into this Deque. These and the bulk pops normalize().
+    void push_back_n(const T* src, size_type count);
+    void push_front_n(const T* src, size_type count);
+
+    // Bulk pops into out[0, count) in front-to-back order, return how many.
+    // If an assignment into out throws, the Deque keeps all its elements.
+    size_type pop_front_n(T* out, size_type count);
+    size_type pop_back_n(T* out, size_type count);
+
+#ifdef WRAPBUFFER_SNAPSHOT
+    // Write a binary snapshot to "fd" (format in snapshot.h) with one
+    // writev of the header and the ring's runs, T trivially copyable
+    void save(int fd) const;
+
+    // Replace the elements with a snapshot read from "fd", throws (leaving
+    // the Deque empty) if it is not a snapshot of T or fails its checksum
+    void load(int fd);
+
+    // Map the snapshot file at "path" read-only, reads come from the mapping
+    static MappedDeque<T> map_readonly(const char* path);
+#endif
+
+    // Iterators over the elements from front to back
+    iterator begin() { return iterator(this, 0); }
+    iterator end() { return iterator(this, size); }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, size); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+    reverse_iterator rbegin() { return reverse_iterator(end()); }
+    reverse_iterator rend() { return reverse_iterator(begin()); }
+    const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+    const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+    // Call f(pointer, count) on each contiguous run of elements, front to back.
+    // The const form of a reversed Deque cannot normalize() and gives runs of one.
+    template <typename F>
+    void for_each_segment(F f);
+    template <typename F>
+    void for_each_segment(F f) const;
+
+    // Call f(element) on every element, one plain loop per run
+    template <typename F>
+    void for_each(F f);
+    template <typename F>
+    void for_each(F f) const;
+
+  protected:
+    // Take over rhs's array, indices and policy, this must hold no array.
+    // The allocators are neither compared nor exchanged, so a derived class
+    // may only hand over an array that its own allocator can free.
+    void take_storage(Deque& rhs);
+
+  private:
+    using alloc_traits = std::allocator_traits<Allocator>;
+
+    // The Stats policy, an empty base unless it counts something
+    Stats& counters() { return *this; }
+    const Stats& counters() const { return *this; }
+
+    // Map a raw position onto a slot of the array
+    size_type wrap(size_type x) const { return Wrap::index(x, capacity); }
+
+    // Map a logical position onto a slot of the array, through the orientation
+    size_type slot(size_type pos) const { return wrap(b + (reversed ? size - 1 - pos : pos)); }
+
+    // Push and pop at the physical ends of the array, ignoring the orientation
+    template <typename... Args>
+    T& emplace_at_back(Args&&... args);
+    template <typename... Args>
+    T& emplace_at_front(Args&&... args);
+    T pop_at_back();
+    T pop_at_front();
+
+    // Call f(pointer, count) on [b, capacity) and [0, e), or in the opposite order if backwards
+    template <typename F>
+    void physical_segments(F f, bool backwards = false) const;
+
+    // Reallocation of the Deque
+    void reallocate(size_type new_capacity);
+
+    // Destroy every element and free the array, without counting a shrink
+    void release_storage();
+
+    // Helpers for the bulk operations
+    void grow_for(size_type count);
+    void copy_in(size_type pos, const T* src, size_type count);
+    void move_out(size_type pos, T* out, size_type count);
+    void shrink_after_pop();
+
+    // Whether the shrink policy halves an array of "cap" slots at the current size
+    bool shrink_wanted(size_type cap) const;
+
+    // Zero "bytes" bytes at "p" in a way the compiler cannot drop as a dead store
+    static void wipe(void* p, std::size_t bytes);
+
+    size_type b;         // Index of the first element
+    size_type e;         // Index one past the last element
+    size_type size;      // Number of constructed elements
+    size_type capacity;  // Number of slots in the array
+    T* array;            // Raw storage, only [b, e) (wrapped) is constructed
+    Allocator alloc;     // Source of the storage
+    ShrinkPolicy shrink; // When pops give memory back
+    bool reversed;       // Whether the front is at "e" and the back at "b"
+
+    // Random-access iterator, holds the Deque and a logical position
+    template <bool IsConst>
+    class basic_iterator
+    {
+      using owner_type = std::conditional_t<IsConst, const Deque, Deque>;
+      friend class Deque;
+      friend class basic_iterator<!IsConst>;
+
+    public:
+      using iterator_category = std::random_access_iterator_tag;
+      using value_type        = T;
+      using difference_type   = std::ptrdiff_t;
+      using pointer           = std::conditional_t<IsConst, const T*, T*>;
+      using reference         = std::conditional_t<IsConst, const T&, T&>;
+
+      basic_iterator() : owner(nullptr), pos(0) {}
+
+      // An iterator converts to a const_iterator
+      template <bool C = IsConst, typename = std::enable_if_t<C>>
+      basic_iterator(const basic_iterator<false>& other) : owner(other.owner), pos(other.pos) {}
+
+      reference operator*() const { return owner->array[owner->slot(pos)]; }
+      pointer operator->() const { return &**this; }
+      reference operator[](difference_type n) const { return *(*this + n); }
+
+      basic_iterator& operator++() { ++pos; return *this; }
+      basic_iterator& operator--() { --pos; return *this; }
+      basic_iterator operator++(int) { basic_iterator old(*this); ++pos; return old; }
+      basic_iterator operator--(int) { basic_iterator old(*this); --pos; return old; }
+      basic_iterator& operator+=(difference_type n) { pos += n; return *this; }
+      basic_iterator& operator-=(difference_type n) { pos -= n; return *this; }
+
+      friend basic_iterator operator+(basic_iterator it, difference_type n) { return it += n; }
+      friend basic_iterator operator+(difference_type n, basic_iterator it) { return it += n; }
+      friend basic_iterator operator-(basic_iterator it, difference_type n) { return it -= n; }
+      friend difference_type operator-(const basic_iterator& l, const basic_iterator& r) 
+      {
+        return static_cast<difference_type>(l.pos) - static_cast<difference_type>(r.pos);
+      }
+
+      friend bool operator==(const basic_iterator& l, const basic_iterator& r) { return l.pos == r.pos; }
+      friend bool operator!=(const basic_iterator& l, const basic_iterator& r) { return l.pos != r.pos; }
+      friend bool operator<(const basic_iterator& l, const basic_iterator& r) { return l.pos < r.pos; }
+      friend bool operator>(const basic_iterator& l, const basic_iterator& r) { return l.pos > r.pos; }
+      friend bool operator<=(const basic_iterator& l, const basic_iterator& r) { return l.pos <= r.pos; }
+      friend bool operator>=(const basic_iterator& l, const basic_iterator& r) { return l.pos >= r.pos; }
+
+    private:
+      basic_iterator(owner_type* owner_, size_type pos_) : owner(owner_), pos(pos_) {}
+
+      owner_type* owner; // Deque being walked
+      size_type pos;     // Logical index, 0 is the front
+    };
+  };
+
+  // Write the elements as text, "format" picks the separators (text_io.h)
+  template <typename T, typename Allocator, typename Wrap, typename Stats>
+  std::ostream& write_text(std::ostream& os, const Deque<T, Allocator, Wrap, Stats>& d, const TextFormat& format = TextFormat());
+
+  // Append every value up to the end of "is", values are split by whitespace
+  // and the characters of format's separators. A token that does not parse
+  // stops the read and sets failbit.
+  template <typename T, typename Allocator, typename Wrap, typename Stats>
+  std::istream& read_text(std::istream& is, Deque<T, Allocator, Wrap, Stats>& d, const TextFormat& format = TextFormat());
+
+  // Stream Operator Overload
+  template <typename T, typename Allocator, typename Wrap, typename Stats>
+  std::ostream& operator<<(std::ostream& os, const Deque<T, Allocator, Wrap, Stats>& d);
+
+  // Stream Extraction Overload, appends values until the end of "is"
+  template <typename T, typename Allocator, typename Wrap, typename Stats>
+  std::istream& operator>>(std::istream& is, Deque<T, Allocator, Wrap, Stats>& d);
+
+  // Expression for "lhs + rhs", where each side is a Deque D or another
+  // DequeConcat. It only records its operands: converting it to a D sums
+  // their sizes, allocates once and appends each operand run by run.
+  // Deque operands are held by reference, so the expression has to be
+  // converted before they go away (use D, not auto, to store a sum).
+  template <typename D, typename Lhs, typename Rhs>
+  class DequeConcat
+  {
+    // Deques are referenced, nested expressions are small enough to copy
+    template <typename X>
+    using operand_type = std::conditional_t<std::is_same<X, D>::value, const D&, X>;
+
+    template <typename, typename, typename>
+    friend class DequeConcat;
+
+  public:
+    using size_type = typename D::size_type;
+
+    DequeConcat(const Lhs& lhs_, const Rhs& rhs_) : lhs(lhs_), rhs(rhs_) {}
+
+    // Number of elements in the result
+    size_type Size() const;
+
+    // Whether d is one of the operands
+    bool refers_to(const D* d) const;
+
+    // Append every operand to out, which must have room for all of them
+    void append_to(D& out) const;
+
+    // Evaluate into a new Deque, one allocation
+    operator D() const;
+
+    // Copy, Flip, and Return the result
+    D operator~() const;
+
+    // Extend the chain
+    DequeConcat<D, DequeConcat, D> operator+(const D& next) const;
+    template <typename L2, typename R2>
+    DequeConcat<D, DequeConcat, DequeConcat<D, L2, R2>> operator+(const DequeConcat<D, L2, R2>& next) const;
+
+  private:
+    // Left-most Deque, whose allocator and shrink policy the result takes
+    const D& front() const;
+
+    operand_type<Lhs> lhs; // Left operand
+    operand_type<Rhs> rhs; // Right operand
+  };
+
+  // Stream Operator Overload, prints the evaluated result
+  template <typename D, typename Lhs, typename Rhs>
+  std::ostream& operator<<(std::ostream& os, const DequeConcat<D, Lhs, Rhs>& expr);
+
+  namespace pmr {
+
+    // Deque whose storage comes from a std::pmr::memory_resource
+    template <typename T, typename Wrap = ModuloWrap, typename Stats = NoStats>
+    using Deque = WrapBuffer::Deque<T, std::pmr::polymorphic_allocator<T>, Wrap, Stats>;
+
+  }
+
+}
+
+#include "deque.tpp"
+
+#endif // WRAPBUFFER_DEQUE_H
+
+//-----------------------------------------------------------------------------
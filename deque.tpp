@@ -0,0 +1,1583 @@
+/*!*****************************************************************************
+*\file     deque.tpp
+*\author   Jalin A. Brown
+*\email    JalinBrownWorks@gmail.com
+
+*\brief Description:
+  Implementation of a circular array - an array that supports efficient insert
+  on both ends.
+
+  NOTE: e = (e + 1) % capacity;
+
+  1) Increment "e" by 1: 
+  The current value of "e" is incremented by 1. 
+  This step is essential for moving to the next position in the data structure.
+
+  2) Calculate the remainder: 
+  After incrementing "e," calculate the remainder when dividing the updated
+  "e" by the "capacity."
+
+  3) Assign the result to "e": 
+  The calculated remainder, which represents the new position of "e" within 
+  the data structure, is then assigned back to "e." This step ensures that 
+  "e" wraps around to the beginning of the data structure when it reaches its 
+  capacity, creating a circular wrap-around effect for efficient data storage.
+
+  The remainder is taken through wrap(), which defers to the Wrap policy.
+  With PowerOfTwoWrap the capacity is always a power of two and the same
+  step is computed as e = (e + 1) & (capacity - 1), avoiding the division.
+
+  Only the slots between "b" and "e" hold live objects. Every other slot is
+  raw storage, so elements are created with the allocator's construct and
+  ended with its destroy as they enter and leave the ring.
+
+******************************************************************************/
+
+//-----------------------------------------------------------------------------
+// Includes:
+//-----------------------------------------------------------------------------
+
+#include "deque.h"
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <cstring>
+#include <utility>
+
+//-----------------------------------------------------------------------------
+// Public Structures:
+//-----------------------------------------------------------------------------
+
+namespace WrapBuffer {
+
+  //-----------------------------------------------------------------------------
+  // Public Functions:
+  //-----------------------------------------------------------------------------
+
+  // Default CTOR
+  template <typename T, typename Allocator, typename Wrap, typename Stats>
+  Deque<T, Allocator, Wrap, Stats>::Deque() : Deque(Allocator()) {}
+
+  //-------------------------------------------------------------------------
+
+  // Allocator CTOR
+  template <typename T, typename Allocator, typename Wrap, typename Stats>
+  Deque<T, Allocator, Wrap, Stats>::Deque(const Allocator& alloc_) 
+    : b(0), e(0), size(0), capacity(0), array(nullptr), alloc(alloc_), shrink(), reversed(false) {}
+
+  //-------------------------------------------------------------------------
+
+  // Shrink Policy CTOR
+  template <typename T, typename Allocator, typename Wrap, typename Stats>
+  Deque<T, Allocator, Wrap, Stats>::Deque(const ShrinkPolicy& policy, const Allocator& alloc_) : Deque(alloc_)
+  {
+    set_shrink_policy(policy);
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Parameterized CTOR
+  template <typename T, typename Allocator, typename Wrap, typename Stats>
+  Deque<T, Allocator, Wrap, Stats>::Deque(const T* array_, size_type size_, const Allocator& alloc_) : Deque(alloc_)
+  {
+    if (size_)
+    {
+      reallocate(size_);
+      for (; size < size_; ++size) 
+      {
+        alloc_traits::construct(alloc, array + size, array_[size]);
+      }
+      e = wrap(size);
+      counters().on_size(size);
+    }
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Copy CTOR
+  template <typename T, typename Allocator, typename Wrap, typename Stats>
+  Deque<T, Allocator, Wrap, Stats>::Deque(const Deque& rhs) 
+    : Deque(rhs, alloc_traits::select_on_container_copy_construction(rhs.alloc)) {}
+
+  //-------------------------------------------------------------------------
+
+  // Copy CTOR into storage from a given allocator
+  template <typename T, typename Allocator, typename Wrap, typename Stats>
+  Deque<T, Allocator, Wrap, Stats>::Deque(const Deque& rhs, const Allocator& alloc_) 
+    : b(0), e(0), size(0), capacity(0), array(nullptr), alloc(alloc_), shrink(rhs.shrink), reversed(rhs.reversed)
+  {
+    if (rhs.size)
+    {
+      // Copy the array as it is, a pending reverse() carries over with the flag.
+      reallocate(rhs.size);
+      rhs.physical_segments([this](const T* src, size_type count) 
+      {
+        for (size_type i = 0; i < count; ++i, ++size) 
+        {
+          alloc_traits::construct(alloc, array + size, src[i]);
+        }
+      });
+      e = wrap(size);
+      counters().on_size(size);
+    }
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Move CTOR, takes over rhs's array and leaves rhs empty
+  template <typename T, typename Allocator, typename Wrap, typename Stats>
+  Deque<T, Allocator, Wrap, Stats>::Deque(Deque&& rhs) noexcept 
+    : b(0), e(0), size(0), capacity(0), array(nullptr), alloc(std::move(rhs.alloc)), shrink(rhs.shrink), reversed(false)
+  {
+    take_storage(rhs);
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Assignment Operator
+  template <typename T, typename Allocator, typename Wrap, typename Stats>
+  Deque<T, Allocator, Wrap, Stats>& Deque<T, Allocator, Wrap, Stats>::operator=(const Deque& rhs) 
+  {
+    if (this != &rhs) 
+    {
+      // Build the copy first, so a throwing copy leaves this Deque untouched.
+      // Unless allocators propagate on copy, the copy has to live in our storage.
+      // The old array is replaced, not shrunk, so it is freed uncounted.
+      if constexpr (alloc_traits::propagate_on_container_copy_assignment::value) 
+      {
+        Deque local(rhs, rhs.alloc);
+        release_storage();
+        alloc = rhs.alloc;
+        take_storage(local);
+      }
+      else 
+      {
+        Deque local(rhs, alloc);
+        release_storage();
+        take_storage(local);
+      }
+    }
+    return *this;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Move Assignment Operator
+  template <typename T, typename Allocator, typename Wrap, typename Stats>
+  Deque<T, Allocator, Wrap, Stats>& Deque<T, Allocator, Wrap, Stats>::operator=(Deque&& rhs) 
+    noexcept(alloc_traits::propagate_on_container_move_assignment::value 
+          || alloc_traits::is_always_equal::value) 
+  {
+    if (this == &rhs) 
+    {
+      return *this;
+    }
+
+    if constexpr (alloc_traits::propagate_on_container_move_assignment::value) 
+    {
+      release_storage();
+      alloc = std::move(rhs.alloc);
+      take_storage(rhs);
+    }
+    else if constexpr (alloc_traits::is_always_equal::value) 
+    {
+      release_storage();
+      take_storage(rhs);
+    }
+    else if (alloc == rhs.alloc) 
+    {
+      release_storage();
+      take_storage(rhs);
+    }
+    else 
+    {
+      // Our allocator cannot free rhs's array, so move the elements across.
+      Deque local(rhs.shrink, alloc);
+      local.reserve(rhs.size);
+      rhs.for_each([&local](T& value) 
+      {
+        local.emplace_back(std::move(value));
+      });
+      rhs.Clear();
+      release_storage();
+      take_storage(local);
+    }
+    return *this;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // DTOR
+  template <typename T, typename Allocator, typename Wrap, typename Stats>
+  Deque<T, Allocator, Wrap, Stats>::~Deque() 
+  {
+    Clear();
+    if (array) 
+    {
+      alloc_traits::deallocate(alloc, array, capacity);
+    }
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Get the size of the Deque
+  template <typename T, typename Allocator, typename Wrap, typename Stats>
+  typename Deque<T, Allocator, Wrap, Stats>::size_type Deque<T, Allocator, Wrap, Stats>::Size() const 
+  {
+    return size;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Check if the Deque is empty
+  template <typename T, typename Allocator, typename Wrap, typename Stats>
+  bool Deque<T, Allocator, Wrap, Stats>::Empty() const 
+  {
+    return (size == 0);
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Clear the Deque
+  template <typename T, typename Allocator, typename Wrap, typename Stats>
+  void Deque<T, Allocator, Wrap, Stats>::Clear() 
+  {
+    // Nothing to end for trivially destructible T, the slots just become raw storage.
+    if constexpr (!std::is_trivially_destructible<T>::value) 
+    {
+      for (size_type i = 0; i < size; ++i) 
+      {
+        alloc_traits::destroy(alloc, array + wrap(b + i));
+      }
+    }
+    size = 0;
+    b = 0;
+    e = 0;
+    reversed = false;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Clear the Deque and free its array
+  template <typename T, typename Allocator, typename Wrap, typename Stats>
+  void Deque<T, Allocator, Wrap, Stats>::Clear_and_release() 
+  {
+    reallocate(0);
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Clear the Deque and overwrite every slot of the array with zeros
+  template <typename T, typename Allocator, typename Wrap, typename Stats>
+  void Deque<T, Allocator, Wrap, Stats>::Secure_clear() 
+  {
+    Clear();
+    if (array) 
+    {
+      wipe(array, capacity * sizeof(T));
+    }
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Get the capacity of the Deque
+  template <typename T, typename Allocator, typename Wrap, typename Stats>
+  typename Deque<T, Allocator, Wrap, Stats>::size_type Deque<T, Allocator, Wrap, Stats>::Capacity() const 
+  {
+    return capacity;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Get the allocator of the Deque
+  template <typename T, typename Allocator, typename Wrap, typename Stats>
+  Allocator Deque<T, Allocator, Wrap, Stats>::get_allocator() const 
+  {
+    return alloc;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Counters kept by the Stats policy
+  template <typename T, typename Allocator, typename Wrap, typename Stats>
+  DequeStats Deque<T, Allocator, Wrap, Stats>::stats() const 
+  {
+    return counters().snapshot();
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Get the shrink policy of the Deque
+  template <typename T, typename Allocator, typename Wrap, typename Stats>
+  const ShrinkPolicy& Deque<T, Allocator, Wrap, Stats>::shrink_policy() const 
+  {
+    return shrink;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Set the shrink policy of the Deque
+  template <typename T, typename Allocator, typename Wrap, typename Stats>
+  void Deque<T, Allocator, Wrap, Stats>::set_shrink_policy(const ShrinkPolicy& policy) 
+  {
+    // A factor of 2 or less would shrink a Deque straight back to full.
+    if (policy.shrink_factor <= 2) 
+    {
+      throw std::invalid_argument("shrink_factor must be greater than 2");
+    }
+    shrink = policy;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Make room for at least "count" elements without further reallocation
+  template <typename T, typename Allocator, typename Wrap, typename Stats>
+  void Deque<T, Allocator, Wrap, Stats>::reserve(size_type count) 
+  {
+    if (count > capacity) 
+    {
+      reallocate(count);
+    }
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Release unused slots, keeping at least the policy's minimum capacity
+  template <typename T, typename Allocator, typename Wrap, typename Stats>
+  void Deque<T, Allocator, Wrap, Stats>::shrink_to_fit() 
+  {
+    size_type fitted = (size > shrink.min_capacity) ? size : shrink.min_capacity;
+    if (Wrap::round_capacity(fitted) < capacity) 
+    {
+      reallocate(fitted);
+    }
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Push a value to the back of the Deque
+  template <typename T, typename Allocator, typename Wrap, typename Stats>
+  void Deque<T, Allocator, Wrap, Stats>::Push_back(const T& val) 
+  {
+    emplace_back(val);
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Push a value to the back of the Deque
+  template <typename T, typename Allocator, typename Wrap, typename Stats>
+  void Deque<T, Allocator, Wrap, Stats>::Push_back(T&& val) 
+  {
+    emplace_back(std::move(val));
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Construct a value in place at the back of the Deque
+  template <typename T, typename Allocator, typename Wrap, typename Stats>
+  template <typename... Args>
+  T& Deque<T, Allocator, Wrap, Stats>::emplace_back(Args&&... args) 
+  {
+    return reversed ? emplace_at_front(std::forward<Args>(args)...) 
+                    : emplace_at_back(std::forward<Args>(args)...);
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Pop the value from the back of the Deque
+  template <typename T, typename Allocator, typename Wrap, typename Stats>
+  T Deque<T, Allocator, Wrap, Stats>::Pop_back() 
+  {
+    static_assert(std::is_default_constructible<T>::value, "Pop_back returns T() on an empty Deque, use pop_back_n for this T");
+    return reversed ? pop_at_front() : pop_at_back();
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Construct a value in place at the back of the array
+  template <typename T, typename Allocator, typename Wrap, typename Stats>
+  template <typename... Args>
+  T& Deque<T, Allocator, Wrap, Stats>::emplace_at_back(Args&&... args) 
+  {
+    // Check if the Deque is full and needs reallocation
+    if (size == capacity) 
+    {
+      // The arguments may refer to an element of this Deque, 
+      // so build the value before the old buffer goes away.
+      T value(std::forward<Args>(args)...);
+      reallocate(capacity ? capacity * 2 : 1);
+      alloc_traits::construct(alloc, array + e, std::move(value));
+    }
+    else 
+    {
+      // Add the new value to the back of the Deque
+      alloc_traits::construct(alloc, array + e, std::forward<Args>(args)...);
+    }
+
+    T& added = array[e];
+
+    // Update the end index while considering circular wrap-around
+    e = wrap(e + 1);
+    if (e == 0) 
+    {
+      counters().on_wrap();
+    }
+
+    // Increase the size to reflect the added element
+    size++;
+    counters().on_size(size);
+
+    return added;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Pop the value from the back of the array
+  template <typename T, typename Allocator, typename Wrap, typename Stats>
+  T Deque<T, Allocator, Wrap, Stats>::pop_at_back() 
+  {
+    if (size == 0) 
+    {
+      counters().on_empty_pop();
+      return T();
+    }
+
+    if (shrink_wanted(capacity)) 
+    {
+      reallocate(capacity / 2);
+    }
+
+    e = wrap(e - 1 + capacity);
+    if (e == capacity - 1) 
+    {
+      counters().on_wrap();
+    }
+    T removedValue(std::move(array[e]));
+    alloc_traits::destroy(alloc, array + e);
+    size--;
+
+    return removedValue;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Index Operator with Reference
+  template <typename T, typename Allocator, typename Wrap, typename Stats>
+  T& Deque<T, Allocator, Wrap, Stats>::operator[](size_type pos) 
+  {
+    if (size == 0 || pos >= size) 
+    {
+      throw std::out_of_range("Index out of range");
+    }
+    return array[slot(pos)];
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Index Operator
+  template <typename T, typename Allocator, typename Wrap, typename Stats>
+  const T& Deque<T, Allocator, Wrap, Stats>::operator[](size_type pos) const 
+  {
+    if (size == 0 || pos >= size) 
+    {
+      throw std::out_of_range("Index out of range");
+    }
+    return array[slot(pos)];
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Swap two Deques
+  template <typename T, typename Allocator, typename Wrap, typename Stats>
+  void Deque<T, Allocator, Wrap, Stats>::swap(Deque& other) 
+  {
+    std::swap(b, other.b);
+    std::swap(e, other.e);
+    std::swap(size, other.size);
+    std::swap(capacity, other.capacity);
+    std::swap(array, other.array);
+    std::swap(shrink, other.shrink);
+    std::swap(reversed, other.reversed);
+    counters().on_size(size);
+    counters().on_capacity(capacity);
+    other.counters().on_size(other.size);
+    other.counters().on_capacity(other.capacity);
+
+    // Allocators that do not propagate must already compare equal.
+    if constexpr (alloc_traits::propagate_on_container_swap::value) 
+    {
+      using std::swap;
+      swap(alloc, other.alloc);
+    }
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Push a value to the front of the Deque
+  template <typename T, typename Allocator, typename Wrap, typename Stats>
+  void Deque<T, Allocator, Wrap, Stats>::Push_front(const T& val) 
+  {
+    emplace_front(val);
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Push a value to the front of the Deque
+  template <typename T, typename Allocator, typename Wrap, typename Stats>
+  void Deque<T, Allocator, Wrap, Stats>::Push_front(T&& val) 
+  {
+    emplace_front(std::move(val));
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Construct a value in place at the front of the Deque
+  template <typename T, typename Allocator, typename Wrap, typename Stats>
+  template <typename... Args>
+  T& Deque<T, Allocator, Wrap, Stats>::emplace_front(Args&&... args) 
+  {
+    return reversed ? emplace_at_back(std::forward<Args>(args)...) 
+                    : emplace_at_front(std::forward<Args>(args)...);
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Pop a value from the front of the Deque
+  template <typename T, typename Allocator, typename Wrap, typename Stats>
+  T Deque<T, Allocator, Wrap, Stats>::Pop_front() 
+  {
+    static_assert(std::is_default_constructible<T>::value, "Pop_front returns T() on an empty Deque, use pop_front_n for this T");
+    return reversed ? pop_at_back() : pop_at_front();
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Construct a value in place at the front of the array
+  template <typename T, typename Allocator, typename Wrap, typename Stats>
+  template <typename... Args>
+  T& Deque<T, Allocator, Wrap, Stats>::emplace_at_front(Args&&... args) 
+  {
+    if (size == capacity) 
+    {
+      // The arguments may refer to an element of this Deque, 
+      // so build the value before the old buffer goes away.
+      T value(std::forward<Args>(args)...);
+      reallocate(capacity ? capacity * 2 : 1);
+
+      // Calculate the new begin (b) index and insert the value at that position.
+      b = wrap(b - 1 + capacity);
+      alloc_traits::construct(alloc, array + b, std::move(value));
+    }
+    else 
+    {
+      // Calculate the new begin (b) index and insert the value at that position.
+      b = wrap(b - 1 + capacity);
+      alloc_traits::construct(alloc, array + b, std::forward<Args>(args)...);
+    }
+    if (b == capacity - 1) 
+    {
+      counters().on_wrap();
+    }
+    size++;
+    counters().on_size(size);
+
+    return array[b];
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Pop a value from the front of the array
+  template <typename T, typename Allocator, typename Wrap, typename Stats>
+  T Deque<T, Allocator, Wrap, Stats>::pop_at_front() 
+  {
+    if (size == 0) 
+    {
+      counters().on_empty_pop();
+      return T();
+    }
+
+    if (shrink_wanted(capacity)) 
+    {
+      reallocate(capacity / 2);
+    }
+
+    T removedValue(std::move(array[b]));
+    alloc_traits::destroy(alloc, array + b);
+    b = wrap(b + 1);
+    if (b == 0) 
+    {
+      counters().on_wrap();
+    }
+    size--;
+
+    return removedValue;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Addition and assignment operator +=
+  template <typename T, typename Allocator, typename Wrap, typename Stats>
+  Deque<T, Allocator, Wrap, Stats>& Deque<T, Allocator, Wrap, Stats>::operator+=(const Deque& rhs) 
+  {
+    if (!rhs.Empty()) 
+    {
+      // Appending needs this Deque in array order. A reversed rhs hands
+      // over its elements one at a time through the const for_each_segment.
+      normalize();
+
+      size_type count = rhs.size;
+      size_type totalSize = size + count;
+
+      // If the combined size exceeds the current capacity, reallocate the array to accommodate the new elements.
+      // Growth is geometric so that repeated appends, such as a + b + c, stay amortized O(1) per element.
+      grow_for(count);
+
+      //1. Copy the elements from the rhs Deque to the current Deque, one contiguous run of rhs at a time.
+      size_type appended = 0;
+      rhs.for_each_segment([&](const T* run, size_type runSize) 
+      {
+        //2. Calculate the proper indices for appending, considering the circular nature of the Deque.
+        copy_in(wrap(e + appended), run, runSize);
+        appended += runSize;
+      });
+
+      //3. Update the size and the end (e) index of the current Deque to reflect the combined Deque.
+      if (e + count >= capacity) 
+      {
+        counters().on_wrap();
+      }
+      size = totalSize;
+      e = wrap(e + count);
+      counters().on_size(size);
+    }
+
+    // Return a reference to the modified Deque 
+    return *this;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Append every operand of a concatenation with at most one reallocation
+  template <typename T, typename Allocator, typename Wrap, typename Stats>
+  template <typename Lhs, typename Rhs>
+  Deque<T, Allocator, Wrap, Stats>& Deque<T, Allocator, Wrap, Stats>::operator+=(const DequeConcat<Deque, Lhs, Rhs>& rhs) 
+  {
+    if (rhs.refers_to(this)) 
+    {
+      // Appending would change an operand while it is read, evaluate first.
+      Deque sum(rhs);
+      return *this += sum;
+    }
+
+    grow_for(rhs.Size());
+    rhs.append_to(*this);
+    return *this;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Addition Operator +
+  template <typename T, typename Allocator, typename Wrap, typename Stats>
+  DequeConcat<Deque<T, Allocator, Wrap, Stats>, Deque<T, Allocator, Wrap, Stats>, Deque<T, Allocator, Wrap, Stats>> 
+    Deque<T, Allocator, Wrap, Stats>::operator+(const Deque& rhs) const& 
+  {
+    return DequeConcat<Deque, Deque, Deque>(*this, rhs);
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Addition Operator +
+  template <typename T, typename Allocator, typename Wrap, typename Stats>
+  template <typename Lhs, typename Rhs>
+  DequeConcat<Deque<T, Allocator, Wrap, Stats>, Deque<T, Allocator, Wrap, Stats>, DequeConcat<Deque<T, Allocator, Wrap, Stats>, Lhs, Rhs>> 
+    Deque<T, Allocator, Wrap, Stats>::operator+(const DequeConcat<Deque, Lhs, Rhs>& rhs) const& 
+  {
+    return DequeConcat<Deque, Deque, DequeConcat<Deque, Lhs, Rhs>>(*this, rhs);
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Addition Operator + on a temporary, appends into its array
+  template <typename T, typename Allocator, typename Wrap, typename Stats>
+  Deque<T, Allocator, Wrap, Stats> Deque<T, Allocator, Wrap, Stats>::operator+(const Deque& rhs) && 
+  {
+    *this += rhs;
+    return std::move(*this);
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Addition Operator + on a temporary, appends into its array
+  template <typename T, typename Allocator, typename Wrap, typename Stats>
+  template <typename Lhs, typename Rhs>
+  Deque<T, Allocator, Wrap, Stats> Deque<T, Allocator, Wrap, Stats>::operator+(const DequeConcat<Deque, Lhs, Rhs>& rhs) && 
+  {
+    *this += rhs;
+    return std::move(*this);
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Reverse the values of the Deque
+  template <typename T, typename Allocator, typename Wrap, typename Stats>
+  Deque<T, Allocator, Wrap, Stats>& Deque<T, Allocator, Wrap, Stats>::reverse() 
+  {
+    // Only the orientation changes, normalize() moves the elements if needed.
+    reversed = !reversed;
+    return *this;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Apply a pending reverse() to the array so runs are front to back again
+  template <typename T, typename Allocator, typename Wrap, typename Stats>
+  void Deque<T, Allocator, Wrap, Stats>::normalize() 
+  {
+    if (reversed) 
+    {
+      // Swaps whole vector blocks from both ends where T allows it, and one
+      // pair at a time across the wrap point and in the middle.
+      detail::reverse_ring(array, capacity, b, size);
+      reversed = false;
+    }
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Copy, Flip, and Return a Deque array
+  template <typename T, typename Allocator, typename Wrap, typename Stats>
+  Deque<T, Allocator, Wrap, Stats> Deque<T, Allocator, Wrap, Stats>::operator~() const& 
+  {
+    if (reversed) 
+    {
+      // The array already holds the flipped order, copy it as it is.
+      Deque flipped(*this);
+      flipped.reversed = false;
+      return flipped;
+    }
+
+    Deque flipped(alloc_traits::select_on_container_copy_construction(alloc));
+    flipped.shrink = shrink;
+
+    if (size)
+    {
+      // Copy back to front straight into the new array, no second pass.
+      flipped.reallocate(size);
+      if constexpr (std::is_trivially_copyable<T>::value) 
+      {
+        detail::reverse_copy_ring(array, capacity, b, size, flipped.array);
+        flipped.size = size;
+      }
+      else 
+      {
+        for (size_type i = size; i-- > 0; ++flipped.size) 
+        {
+          alloc_traits::construct(flipped.alloc, flipped.array + flipped.size, array[wrap(b + i)]);
+        }
+      }
+      flipped.e = flipped.wrap(flipped.size);
+      flipped.counters().on_size(flipped.size);
+    }
+
+    return flipped;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Flip a temporary in place and return it
+  template <typename T, typename Allocator, typename Wrap, typename Stats>
+  Deque<T, Allocator, Wrap, Stats> Deque<T, Allocator, Wrap, Stats>::operator~() && 
+  {
+    reverse();
+    return std::move(*this);
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Push "count" values to the back of the Deque, src[0] first
+  template <typename T, typename Allocator, typename Wrap, typename Stats>
+  void Deque<T, Allocator, Wrap, Stats>::push_back_n(const T* src, size_type count) 
+  {
+    if (count == 0) 
+    {
+      return;
+    }
+
+    // Grow once for the whole batch, then copy it in behind "e".
+    normalize();
+    grow_for(count);
+    copy_in(e, src, count);
+    if (e + count >= capacity) 
+    {
+      counters().on_wrap();
+    }
+    e = wrap(e + count);
+    size += count;
+    counters().on_size(size);
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Push "count" values to the front of the Deque, keeping their order
+  template <typename T, typename Allocator, typename Wrap, typename Stats>
+  void Deque<T, Allocator, Wrap, Stats>::push_front_n(const T* src, size_type count) 
+  {
+    if (count == 0) 
+    {
+      return;
+    }
+
+    // Grow once, then copy the batch into the slots just before "b".
+    normalize();
+    grow_for(count);
+    size_type new_b = wrap(b + capacity - count);
+    copy_in(new_b, src, count);
+    if (count > b) 
+    {
+      counters().on_wrap();
+    }
+    b = new_b;
+    size += count;
+    counters().on_size(size);
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Pop up to "count" values from the front into out, returns how many
+  template <typename T, typename Allocator, typename Wrap, typename Stats>
+  typename Deque<T, Allocator, Wrap, Stats>::size_type Deque<T, Allocator, Wrap, Stats>::pop_front_n(T* out, size_type count) 
+  {
+    if (count > size) 
+    {
+      if (size == 0) 
+      {
+        counters().on_empty_pop();
+      }
+      count = size;
+    }
+    if (count == 0) 
+    {
+      return 0;
+    }
+
+    normalize();
+    move_out(b, out, count);
+    if (b + count >= capacity) 
+    {
+      counters().on_wrap();
+    }
+    b = wrap(b + count);
+    size -= count;
+    shrink_after_pop();
+
+    return count;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Pop up to "count" values from the back into out, returns how many
+  template <typename T, typename Allocator, typename Wrap, typename Stats>
+  typename Deque<T, Allocator, Wrap, Stats>::size_type Deque<T, Allocator, Wrap, Stats>::pop_back_n(T* out, size_type count) 
+  {
+    if (count > size) 
+    {
+      if (size == 0) 
+      {
+        counters().on_empty_pop();
+      }
+      count = size;
+    }
+    if (count == 0) 
+    {
+      return 0;
+    }
+
+    // The popped values keep their front-to-back order in out.
+    normalize();
+    size_type new_e = wrap(e + capacity - count);
+    move_out(new_e, out, count);
+    if (count > e) 
+    {
+      counters().on_wrap();
+    }
+    e = new_e;
+    size -= count;
+    shrink_after_pop();
+
+    return count;
+  }
+
+  //-------------------------------------------------------------------------
+
+#ifdef WRAPBUFFER_SNAPSHOT
+
+  // Write a binary snapshot to "fd"
+  template <typename T, typename Allocator, typename Wrap, typename Stats>
+  void Deque<T, Allocator, Wrap, Stats>::save(int fd) const
+  {
+    static_assert(std::is_trivially_copyable<T>::value, "save() needs a trivially copyable T");
+
+    // The runs are written as they lie in the array, a reversed Deque
+    // records that in the header instead of reordering anything.
+    detail::SnapshotChecksum sum;
+    struct iovec iov[3];
+    int count = 1;
+    physical_segments([&](T* run, size_type n)
+    {
+      sum.update(run, n * sizeof(T));
+      iov[count].iov_base = run;
+      iov[count].iov_len = n * sizeof(T);
+      count++;
+    });
+
+    detail::SnapshotHeader header = detail::make_snapshot_header(sizeof(T), size, sum.digest(), reversed);
+    iov[0].iov_base = &header;
+    iov[0].iov_len = sizeof(header);
+    detail::write_all(fd, iov, count);
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Replace the elements with a snapshot read from "fd"
+  template <typename T, typename Allocator, typename Wrap, typename Stats>
+  void Deque<T, Allocator, Wrap, Stats>::load(int fd)
+  {
+    static_assert(std::is_trivially_copyable<T>::value, "load() needs a trivially copyable T");
+
+    detail::SnapshotHeader header;
+    detail::read_all(fd, &header, sizeof(header));
+    detail::check_snapshot_header(header, sizeof(T));
+    if (header.count > static_cast<std::uint64_t>(-1) / sizeof(T) / 2)
+    {
+      throw std::runtime_error("Snapshot too large");
+    }
+
+    // Read straight into the array, the elements only count once they
+    // have all arrived and match the checksum.
+    size_type count = static_cast<size_type>(header.count);
+    Clear();
+    reserve(count);
+    detail::read_all(fd, array, count * sizeof(T));
+
+    detail::SnapshotChecksum sum;
+    sum.update(array, count * sizeof(T));
+    if (sum.digest() != header.checksum)
+    {
+      throw std::runtime_error("Snapshot checksum mismatch");
+    }
+
+    if (count)
+    {
+      b = 0;
+      e = wrap(count);
+      size = count;
+      reversed = (header.flags & detail::SnapshotHeader::reversed_flag) != 0;
+      counters().on_size(size);
+    }
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Map the snapshot file at "path" read-only
+  template <typename T, typename Allocator, typename Wrap, typename Stats>
+  MappedDeque<T> Deque<T, Allocator, Wrap, Stats>::map_readonly(const char* path)
+  {
+    return MappedDeque<T>(path);
+  }
+
+  //-------------------------------------------------------------------------
+
+#endif
+
+  // Call f(pointer, count) on each contiguous run of elements, front to back
+  template <typename T, typename Allocator, typename Wrap, typename Stats>
+  template <typename F>
+  void Deque<T, Allocator, Wrap, Stats>::for_each_segment(F f) 
+  {
+    normalize();
+    physical_segments(f);
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Call f(pointer, count) on each contiguous run of elements, front to back
+  template <typename T, typename Allocator, typename Wrap, typename Stats>
+  template <typename F>
+  void Deque<T, Allocator, Wrap, Stats>::for_each_segment(F f) const 
+  {
+    if (reversed) 
+    {
+      // The array cannot be reordered from here, so each run is one element.
+      size_type count = size;
+      for (size_type i = 0; i < count; ++i) 
+      {
+        f(static_cast<const T*>(array + slot(i)), size_type(1));
+      }
+      return;
+    }
+
+    physical_segments([&f](T* run, size_type count) 
+    {
+      f(static_cast<const T*>(run), count);
+    });
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Call f(element) on every element, one plain loop per run
+  template <typename T, typename Allocator, typename Wrap, typename Stats>
+  template <typename F>
+  void Deque<T, Allocator, Wrap, Stats>::for_each(F f) 
+  {
+    // Walks the runs backwards rather than normalizing a reversed Deque.
+    if (reversed) 
+    {
+      physical_segments([&f](T* run, size_type count) 
+      {
+        for (size_type i = count; i-- > 0;) 
+        {
+          f(run[i]);
+        }
+      }, true);
+      return;
+    }
+
+    physical_segments([&f](T* run, size_type count) 
+    {
+      for (size_type i = 0; i < count; ++i) 
+      {
+        f(run[i]);
+      }
+    });
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Call f(element) on every element, one plain loop per run
+  template <typename T, typename Allocator, typename Wrap, typename Stats>
+  template <typename F>
+  void Deque<T, Allocator, Wrap, Stats>::for_each(F f) const 
+  {
+    if (reversed) 
+    {
+      physical_segments([&f](const T* run, size_type count) 
+      {
+        for (size_type i = count; i-- > 0;) 
+        {
+          f(run[i]);
+        }
+      }, true);
+      return;
+    }
+
+    physical_segments([&f](const T* run, size_type count) 
+    {
+      for (size_type i = 0; i < count; ++i) 
+      {
+        f(run[i]);
+      }
+    });
+  }
+
+  //-------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// Private Functions:
+//-----------------------------------------------------------------------------
+
+  // Reallocation of the Deque
+  template <typename T, typename Allocator, typename Wrap, typename Stats>
+  void Deque<T, Allocator, Wrap, Stats>::reallocate(size_type new_capacity) 
+  {
+    // Let the wrap policy pick the real capacity (e.g. a power of two).
+    new_capacity = Wrap::round_capacity(new_capacity);
+
+    // If new_capacity is zero, delete the array and reset the Deque.
+    if (new_capacity == 0) 
+    {
+      if (array) 
+      {
+        counters().on_shrink(0, 0);
+      }
+      release_storage();
+    }
+    else 
+    {
+      // If new_capacity is non-zero, 
+      // allocate a new array with the specified capacity
+      T* new_array = alloc_traits::allocate(alloc, new_capacity);
+
+      // Move the existing elements to it, 
+      // undoing the partial copy if an element throws.
+      size_type moved = 0;
+      try 
+      {
+        physical_segments([&](T* run, size_type count) 
+        {
+          for (size_type i = 0; i < count; ++i, ++moved) 
+          {
+            alloc_traits::construct(alloc, new_array + moved, std::move_if_noexcept(run[i]));
+          }
+        });
+      }
+      catch (...) 
+      {
+        while (moved) 
+        {
+          alloc_traits::destroy(alloc, new_array + --moved);
+        }
+        alloc_traits::deallocate(alloc, new_array, new_capacity);
+        throw;
+      }
+
+      // Then end the lifetime of the moved-from originals.
+      physical_segments([this](T* run, size_type count) 
+      {
+        for (size_type i = 0; i < count; ++i) 
+        {
+          alloc_traits::destroy(alloc, run + i);
+        }
+      });
+      if (array) 
+      {
+        alloc_traits::deallocate(alloc, array, capacity);
+      }
+
+      // Update indices and capacity accordingly.
+      if (new_capacity > capacity) 
+      {
+        counters().on_grow(size * sizeof(T), new_capacity);
+      }
+      else 
+      {
+        counters().on_shrink(size * sizeof(T), new_capacity);
+      }
+      array = new_array;
+      b = 0;
+      e = Wrap::index(size, new_capacity);
+      capacity = new_capacity;
+    }
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Call f(pointer, count) on [b, capacity) and [0, e), or in the opposite order if backwards
+  template <typename T, typename Allocator, typename Wrap, typename Stats>
+  template <typename F>
+  void Deque<T, Allocator, Wrap, Stats>::physical_segments(F f, bool backwards) const 
+  {
+    if (size == 0) 
+    {
+      return;
+    }
+
+    // The live range is [b, b + size) unless it runs past the end of the
+    // array, in which case it is [b, capacity) followed by [0, e).
+    // Both runs are measured up front so f may append to this Deque.
+    size_type first = (size < capacity - b) ? size : capacity - b;
+    size_type second = size - first;
+    if (backwards && second) 
+    {
+      f(array, second);
+    }
+    f(array + b, first);
+    if (!backwards && second) 
+    {
+      f(array, second);
+    }
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Destroy every element and free the array, without counting a shrink
+  template <typename T, typename Allocator, typename Wrap, typename Stats>
+  void Deque<T, Allocator, Wrap, Stats>::release_storage() 
+  {
+    Clear();
+    if (array) 
+    {
+      alloc_traits::deallocate(alloc, array, capacity);
+    }
+    array = nullptr;
+    capacity = 0;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Take over rhs's array, indices and policy, this must hold no array
+  template <typename T, typename Allocator, typename Wrap, typename Stats>
+  void Deque<T, Allocator, Wrap, Stats>::take_storage(Deque& rhs) 
+  {
+    b = rhs.b;
+    e = rhs.e;
+    size = rhs.size;
+    capacity = rhs.capacity;
+    array = rhs.array;
+    shrink = rhs.shrink;
+    reversed = rhs.reversed;
+    counters().on_size(size);
+    counters().on_capacity(capacity);
+
+    rhs.b = 0;
+    rhs.e = 0;
+    rhs.size = 0;
+    rhs.capacity = 0;
+    rhs.array = nullptr;
+    rhs.reversed = false;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Make room for "count" more elements with at most one reallocation
+  template <typename T, typename Allocator, typename Wrap, typename Stats>
+  void Deque<T, Allocator, Wrap, Stats>::grow_for(size_type count) 
+  {
+    if (size + count > capacity) 
+    {
+      size_type new_capacity = capacity ? capacity * 2 : 1;
+      if (new_capacity < size + count) 
+      {
+        new_capacity = size + count;
+      }
+      reallocate(new_capacity);
+    }
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Construct copies of src[0, count) in the free slots starting at "pos"
+  template <typename T, typename Allocator, typename Wrap, typename Stats>
+  void Deque<T, Allocator, Wrap, Stats>::copy_in(size_type pos, const T* src, size_type count) 
+  {
+    // The slots run to the end of the array and then restart at 0.
+    size_type first = (count < capacity - pos) ? count : capacity - pos;
+
+    if constexpr (std::is_trivially_copyable<T>::value) 
+    {
+      std::memcpy(array + pos, src, first * sizeof(T));
+      std::memcpy(array, src + first, (count - first) * sizeof(T));
+    }
+    else 
+    {
+      size_type done = 0;
+      try 
+      {
+        for (; done < count; ++done) 
+        {
+          alloc_traits::construct(alloc, array + wrap(pos + done), src[done]);
+        }
+      }
+      catch (...) 
+      {
+        while (done) 
+        {
+          alloc_traits::destroy(alloc, array + wrap(pos + --done));
+        }
+        throw;
+      }
+    }
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Move "count" elements starting at slot "pos" into out and destroy them
+  template <typename T, typename Allocator, typename Wrap, typename Stats>
+  void Deque<T, Allocator, Wrap, Stats>::move_out(size_type pos, T* out, size_type count) 
+  {
+    size_type first = (count < capacity - pos) ? count : capacity - pos;
+
+    if constexpr (std::is_trivially_copyable<T>::value) 
+    {
+      std::memcpy(out, array + pos, first * sizeof(T));
+      std::memcpy(out + first, array, (count - first) * sizeof(T));
+    }
+    else 
+    {
+      // Destroy the slots only once every assignment has succeeded. If one
+      // throws, the slots are all still alive inside [b, e), some of them
+      // moved-from, and the caller leaves b, e and size as they were.
+      for (size_type i = 0; i < count; ++i) 
+      {
+        out[i] = std::move(array[wrap(pos + i)]);
+      }
+      for (size_type i = 0; i < count; ++i) 
+      {
+        alloc_traits::destroy(alloc, array + wrap(pos + i));
+      }
+    }
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Halve the array as often as the shrink policy asks, in one reallocation
+  template <typename T, typename Allocator, typename Wrap, typename Stats>
+  void Deque<T, Allocator, Wrap, Stats>::shrink_after_pop() 
+  {
+    size_type new_capacity = capacity;
+    while (shrink_wanted(new_capacity)) 
+    {
+      new_capacity /= 2;
+    }
+    if (new_capacity != capacity) 
+    {
+      reallocate(new_capacity);
+    }
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Whether the shrink policy halves an array of "cap" slots at the current size
+  template <typename T, typename Allocator, typename Wrap, typename Stats>
+  bool Deque<T, Allocator, Wrap, Stats>::shrink_wanted(size_type cap) const 
+  {
+    return shrink.automatic 
+        && cap != 0 
+        && cap / 2 >= shrink.min_capacity 
+        && size <= cap / shrink.shrink_factor;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Zero "bytes" bytes at "p" in a way the compiler cannot drop as a dead store
+  template <typename T, typename Allocator, typename Wrap, typename Stats>
+  void Deque<T, Allocator, Wrap, Stats>::wipe(void* p, std::size_t bytes) 
+  {
+#if defined(__GNUC__)
+    std::memset(p, 0, bytes);
+    // Tell the compiler the zeros may be read, so the memset has to stay.
+    __asm__ __volatile__("" : : "r"(p) : "memory");
+#else
+    volatile unsigned char* bytes_ = static_cast<volatile unsigned char*>(p);
+    for (std::size_t i = 0; i < bytes; ++i) 
+    {
+      bytes_[i] = 0;
+    }
+#endif
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Write the elements as text
+  template <typename T, typename Allocator, typename Wrap, typename Stats>
+  std::ostream& write_text(std::ostream& os, const Deque<T, Allocator, Wrap, Stats>& d, const TextFormat& format) 
+  {
+    return detail::write_elements(os, d, format);
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Append every value up to the end of "is"
+  template <typename T, typename Allocator, typename Wrap, typename Stats>
+  std::istream& read_text(std::istream& is, Deque<T, Allocator, Wrap, Stats>& d, const TextFormat& format) 
+  {
+    if constexpr (detail::fast_text<T>) 
+    {
+      std::istream::sentry ok(is, true);
+      if (ok && detail::plain_stream(is)) 
+      {
+        std::string delimiters(format.separator);
+        delimiters.append(format.terminator.data(), format.terminator.size());
+        detail::TextReader in(is, delimiters);
+
+        // Parse into a batch and append each full one with push_back_n.
+        // The batch is on the heap to keep operator>> light on the stack.
+        const std::size_t batch_size = 1024;
+        std::unique_ptr<T[]> batch(new T[batch_size]);
+        std::size_t count = 0;
+        for (std::string_view token = in.next(); !token.empty(); token = in.next()) 
+        {
+          auto r = std::from_chars(token.data(), token.data() + token.size(), batch[count]);
+          if (r.ec != std::errc() || r.ptr != token.data() + token.size() || in.cut_short()) 
+          {
+            in.unget();
+            is.setstate(std::ios_base::failbit);
+            break;
+          }
+          if (++count == batch_size) 
+          {
+            d.push_back_n(batch.get(), count);
+            count = 0;
+          }
+        }
+        d.push_back_n(batch.get(), count);
+
+        if (in.at_eof()) 
+        {
+          is.setstate(std::ios_base::eofbit);
+        }
+        return is;
+      }
+      if (!ok) 
+      {
+        return is;
+      }
+    }
+
+    // One element at a time, only whitespace separates values here.
+    T value;
+    while (is >> value) 
+    {
+      d.Push_back(std::move(value));
+    }
+    if (is.eof()) 
+    {
+      is.clear(std::ios_base::eofbit);
+    }
+    return is;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Stream Operator Overload
+  template <typename T, typename Allocator, typename Wrap, typename Stats>
+  std::ostream& operator<<(std::ostream& os, const Deque<T, Allocator, Wrap, Stats>& d) 
+  {
+    // Prints the elements followed by spaces.
+    return write_text(os, d);
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Stream Extraction Overload
+  template <typename T, typename Allocator, typename Wrap, typename Stats>
+  std::istream& operator>>(std::istream& is, Deque<T, Allocator, Wrap, Stats>& d) 
+  {
+    return read_text(is, d);
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Number of elements in the result
+  template <typename D, typename Lhs, typename Rhs>
+  typename DequeConcat<D, Lhs, Rhs>::size_type DequeConcat<D, Lhs, Rhs>::Size() const 
+  {
+    return lhs.Size() + rhs.Size();
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Whether d is one of the operands
+  template <typename D, typename Lhs, typename Rhs>
+  bool DequeConcat<D, Lhs, Rhs>::refers_to(const D* d) const 
+  {
+    bool left = false;
+    bool right = false;
+    if constexpr (std::is_same<Lhs, D>::value) 
+    {
+      left = (&lhs == d);
+    }
+    else 
+    {
+      left = lhs.refers_to(d);
+    }
+    if constexpr (std::is_same<Rhs, D>::value) 
+    {
+      right = (&rhs == d);
+    }
+    else 
+    {
+      right = rhs.refers_to(d);
+    }
+    return left || right;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Append every operand to out, which must have room for all of them
+  template <typename D, typename Lhs, typename Rhs>
+  void DequeConcat<D, Lhs, Rhs>::append_to(D& out) const 
+  {
+    // Each Deque goes in through operator+=, at most two runs apiece.
+    if constexpr (std::is_same<Lhs, D>::value) 
+    {
+      out += lhs;
+    }
+    else 
+    {
+      lhs.append_to(out);
+    }
+    if constexpr (std::is_same<Rhs, D>::value) 
+    {
+      out += rhs;
+    }
+    else 
+    {
+      rhs.append_to(out);
+    }
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Evaluate into a new Deque, one allocation
+  template <typename D, typename Lhs, typename Rhs>
+  DequeConcat<D, Lhs, Rhs>::operator D() const 
+  {
+    using alloc_traits = std::allocator_traits<typename D::allocator_type>;
+
+    const D& first = front();
+    D result(first.shrink_policy(), alloc_traits::select_on_container_copy_construction(first.get_allocator()));
+    result.reserve(Size());
+    append_to(result);
+    return result;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Copy, Flip, and Return the result
+  template <typename D, typename Lhs, typename Rhs>
+  D DequeConcat<D, Lhs, Rhs>::operator~() const 
+  {
+    // The evaluated temporary is flipped in place.
+    return ~static_cast<D>(*this);
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Extend the chain
+  template <typename D, typename Lhs, typename Rhs>
+  DequeConcat<D, DequeConcat<D, Lhs, Rhs>, D> DequeConcat<D, Lhs, Rhs>::operator+(const D& next) const 
+  {
+    return DequeConcat<D, DequeConcat, D>(*this, next);
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Extend the chain
+  template <typename D, typename Lhs, typename Rhs>
+  template <typename L2, typename R2>
+  DequeConcat<D, DequeConcat<D, Lhs, Rhs>, DequeConcat<D, L2, R2>> 
+    DequeConcat<D, Lhs, Rhs>::operator+(const DequeConcat<D, L2, R2>& next) const 
+  {
+    return DequeConcat<D, DequeConcat, DequeConcat<D, L2, R2>>(*this, next);
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Left-most Deque, whose allocator and shrink policy the result takes
+  template <typename D, typename Lhs, typename Rhs>
+  const D& DequeConcat<D, Lhs, Rhs>::front() const 
+  {
+    if constexpr (std::is_same<Lhs, D>::value) 
+    {
+      return lhs;
+    }
+    else 
+    {
+      return lhs.front();
+    }
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Stream Operator Overload, prints the evaluated result
+  template <typename D, typename Lhs, typename Rhs>
+  std::ostream& operator<<(std::ostream& os, const DequeConcat<D, Lhs, Rhs>& expr) 
+  {
+    return os << static_cast<D>(expr);
+  }
+
+  //-------------------------------------------------------------------------
+
+}
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,142 @@
+/*!*****************************************************************************
+*\file     deque_stats.h
+*\author   Jalin A. Brown
+*\email    JalinBrownWorks@gmail.com
+
+*\brief Description:
+  Instrumentation policies for the Deque's last template parameter.
+
+  The Deque reports events to its Stats policy as they happen:
+
+    on_grow(bytes, capacity)    reallocate() made the array larger
+    on_shrink(bytes, capacity)  reallocate() made the array smaller
+    on_size(size)               the size went up
+    on_capacity(capacity)       an array was adopted from another Deque
+    on_wrap()                   "b" or "e" crossed the end of the array
+    on_empty_pop()              a pop found the Deque empty
+
+  "bytes" is how many bytes of elements the reallocation moved. Freeing the
+  old array when a Deque is assigned over is not a shrink, only reallocate()
+  from a pop, shrink_to_fit() or Clear_and_release() counts as one.
+
+  NoStats, the default, has only empty inline hooks and no data, and the
+  Deque holds its policy as an empty base, so an uninstrumented Deque has
+  the same size and code as before.
+
+  CountingStats keeps each counter in a relaxed std::atomic. The Deque
+  itself is single-threaded, so every update is a plain load and store with
+  no locked instruction, and another thread can call stats() at any time
+  for a DequeStats snapshot. Each counter in a snapshot is a value it really
+  had, but counters updated by the same operation may be read on either
+  side of it.
+
+******************************************************************************/
+
+#ifndef WRAPBUFFER_DEQUE_STATS_H
+#define WRAPBUFFER_DEQUE_STATS_H
+
+//-----------------------------------------------------------------------------
+// Includes:
+//-----------------------------------------------------------------------------
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+//-----------------------------------------------------------------------------
+// Public Structures:
+//-----------------------------------------------------------------------------
+
+namespace WrapBuffer {
+
+  // Counters read from a Deque by stats(), all zero under NoStats
+  struct DequeStats
+  {
+    std::uint64_t grows = 0;         // Reallocations to a larger array
+    std::uint64_t shrinks = 0;       // Reallocations to a smaller array
+    std::uint64_t bytes_moved = 0;   // Element bytes moved by reallocations
+    std::uint64_t peak_size = 0;     // Largest size seen
+    std::uint64_t peak_capacity = 0; // Largest capacity seen
+    std::uint64_t wraps = 0;         // Times "b" or "e" crossed the end of the array
+    std::uint64_t empty_pops = 0;    // Pops that found the Deque empty
+  };
+
+  // Counts nothing, every hook compiles away
+  struct NoStats
+  {
+    void on_grow(std::size_t, std::size_t) {}
+    void on_shrink(std::size_t, std::size_t) {}
+    void on_size(std::size_t) {}
+    void on_capacity(std::size_t) {}
+    void on_wrap() {}
+    void on_empty_pop() {}
+    DequeStats snapshot() const { return DequeStats(); }
+  };
+
+  // Counts every event in relaxed atomics, readable from any thread
+  class CountingStats
+  {
+  public:
+    void on_grow(std::size_t bytes, std::size_t capacity)
+    {
+      bump(grows);
+      bump(bytes_moved, bytes);
+      raise(peak_capacity, capacity);
+    }
+
+    void on_shrink(std::size_t bytes, std::size_t)
+    {
+      bump(shrinks);
+      bump(bytes_moved, bytes);
+    }
+
+    void on_size(std::size_t size) { raise(peak_size, size); }
+    void on_capacity(std::size_t capacity) { raise(peak_capacity, capacity); }
+    void on_wrap() { bump(wraps); }
+    void on_empty_pop() { bump(empty_pops); }
+
+    // Read every counter
+    DequeStats snapshot() const
+    {
+      DequeStats s;
+      s.grows = grows.load(std::memory_order_relaxed);
+      s.shrinks = shrinks.load(std::memory_order_relaxed);
+      s.bytes_moved = bytes_moved.load(std::memory_order_relaxed);
+      s.peak_size = peak_size.load(std::memory_order_relaxed);
+      s.peak_capacity = peak_capacity.load(std::memory_order_relaxed);
+      s.wraps = wraps.load(std::memory_order_relaxed);
+      s.empty_pops = empty_pops.load(std::memory_order_relaxed);
+      return s;
+    }
+
+  private:
+    using counter = std::atomic<std::uint64_t>;
+
+    // Only the owning Deque writes, so a load and a store are enough.
+    static void bump(counter& c, std::uint64_t n = 1)
+    {
+      c.store(c.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    }
+
+    static void raise(counter& c, std::uint64_t value)
+    {
+      if (value > c.load(std::memory_order_relaxed))
+      {
+        c.store(value, std::memory_order_relaxed);
+      }
+    }
+
+    counter grows{ 0 };
+    counter shrinks{ 0 };
+    counter bytes_moved{ 0 };
+    counter peak_size{ 0 };
+    counter peak_capacity{ 0 };
+    counter wraps{ 0 };
+    counter empty_pops{ 0 };
+  };
+
+}
+
+#endif // WRAPBUFFER_DEQUE_STATS_H
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,920 @@
+/*!*****************************************************************************
+*\file     incremental_deque.h
+*\author   Jalin A. Brown
+*\email    JalinBrownWorks@gmail.com
+
+*\brief Description:
+  Deque with de-amortized growth: no push or pop ever copies the whole
+  array, so every operation is O(1) in the worst case, not just on average.
+
+  When the ring is full, a ring of twice the capacity is allocated, but the
+  elements stay where they are. Logical position i of the full ring is given
+  slot i of the new one, and those slots are marked pending: their element
+  still lives in the old array.
+
+    new array:  [ migrated | pending [lo, hi) | pushed after growth | free ]
+    old array:  the elements of the pending slots, at old slot old_b + s
+
+  Each push or pop then moves "Step" pending elements (2 by default) into
+  their slots, raising "lo". The new ring has as many free slots as there
+  are pending elements, so with Step >= 2 migration always ends before the
+  ring can fill again, and the old array is freed when "lo" reaches "hi".
+
+  Until then both arrays are live. A read of slot s looks in the old array
+  when s is in [lo, hi). Pops at either end take pending elements straight
+  from the old array and narrow [lo, hi) from that side.
+
+  The bounds are on element moves. Freeing a large old array still costs
+  whatever the allocator takes to unmap it, once per growth.
+
+  Capacities are powers of two, so wrapping is a mask. The ring never
+  shrinks on its own, since a shrink would be another full copy. reserve()
+  and shrink_to_fit() do move everything and are O(n). References to
+  elements are invalidated as elements migrate.
+
+******************************************************************************/
+
+#ifndef WRAPBUFFER_INCREMENTAL_DEQUE_H
+#define WRAPBUFFER_INCREMENTAL_DEQUE_H
+
+//-----------------------------------------------------------------------------
+// Includes:
+//-----------------------------------------------------------------------------
+
+#include "deque.h"
+#include <cstddef>
+#include <iosfwd>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+//-----------------------------------------------------------------------------
+// Public Structures:
+//-----------------------------------------------------------------------------
+
+namespace WrapBuffer {
+
+  template <typename T, typename Allocator = std::allocator<T>, std::size_t Step = 2>
+  class IncrementalDeque
+  {
+    static_assert(Step >= 2, "Step must be at least 2 so migration ends before the ring refills");
+
+    template <bool IsConst>
+    class basic_iterator;
+
+    using alloc_traits = std::allocator_traits<Allocator>;
+
+  public:
+    using value_type             = T;
+    using allocator_type         = Allocator;
+    using size_type              = std::size_t;
+    using difference_type        = std::ptrdiff_t;
+    using reference              = T&;
+    using const_reference        = const T&;
+    using iterator               = basic_iterator<false>;
+    using const_iterator         = basic_iterator<true>;
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    // Default CTOR
+    IncrementalDeque();
+
+    // Allocator CTOR
+    explicit IncrementalDeque(const Allocator& alloc_);
+
+    // Copy CTOR
+    IncrementalDeque(const IncrementalDeque& rhs);
+
+    // Move CTOR, takes rhs's arrays
+    IncrementalDeque(IncrementalDeque&& rhs) noexcept;
+
+    // Assignment Operator
+    IncrementalDeque& operator=(const IncrementalDeque& rhs);
+
+    // Move Assignment Operator
+    IncrementalDeque& operator=(IncrementalDeque&& rhs)
+      noexcept(alloc_traits::propagate_on_container_move_assignment::value
+            || alloc_traits::is_always_equal::value);
+
+    // DTOR
+    ~IncrementalDeque();
+
+    // Get the size of the IncrementalDeque
+    size_type Size() const;
+
+    // Check if the IncrementalDeque is empty
+    bool Empty() const;
+
+    // Clear the IncrementalDeque, keeps the current array
+    void Clear();
+
+    // Get the capacity of the current array
+    size_type Capacity() const;
+
+    // Whether elements are still being moved out of the old array
+    bool migrating() const;
+
+    // Get the allocator
+    Allocator get_allocator() const;
+
+    // Make room for at least "count" elements, O(n)
+    void reserve(size_type count);
+
+    // Release unused slots, O(n)
+    void shrink_to_fit();
+
+    // Push a value to the back of the IncrementalDeque
+    void Push_back(const T& val);
+    void Push_back(T&& val);
+
+    // Construct a value in place at the back of the IncrementalDeque
+    template <typename... Args>
+    T& emplace_back(Args&&... args);
+
+    // Pop the value from the back of the IncrementalDeque, T() when empty
+    T Pop_back();
+
+    // Push a value to the front of the IncrementalDeque
+    void Push_front(const T& val);
+    void Push_front(T&& val);
+
+    // Construct a value in place at the front of the IncrementalDeque
+    template <typename... Args>
+    T& emplace_front(Args&&... args);
+
+    // Pop the value from the front of the IncrementalDeque, T() when empty
+    T Pop_front();
+
+    // Index Operators
+    T& operator[](size_type pos);
+    const T& operator[](size_type pos) const;
+
+    // Swap two IncrementalDeques
+    void swap(IncrementalDeque& other);
+
+    // Iterators
+    iterator begin() { return iterator(this, 0); }
+    iterator end() { return iterator(this, size); }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, size); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+    reverse_iterator rbegin() { return reverse_iterator(end()); }
+    reverse_iterator rend() { return reverse_iterator(begin()); }
+    const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+    const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+    // Call f on every element, front to back
+    template <typename F>
+    void for_each(F f);
+    template <typename F>
+    void for_each(F f) const;
+
+  private:
+    // Whether slot "s" of the current array is still in the old array
+    bool pending(size_type s) const { return s - lo < hi - lo; }
+
+    // Where the element of slot "s" lives
+    T* locate(size_type s) const
+    {
+      return pending(s) ? old_array + ((old_b + s) & (old_capacity - 1)) : array + s;
+    }
+
+    // Element at logical position "pos", unchecked
+    T& element(size_type pos) const { return *locate((b + pos) & (capacity - 1)); }
+
+    // Start a ring of twice the capacity, moves no elements
+    void grow();
+
+    // Move up to Step pending elements into the current array
+    void migrate();
+
+    // Move every pending element
+    void finish_migration();
+
+    // Free the old array once nothing is pending
+    void end_migration_if_done();
+
+    // Move every element into a fresh array of "new_capacity" slots
+    void relocate(size_type new_capacity);
+
+    // Destroy every element and free both arrays
+    void destroy_all();
+
+    // Take rhs's arrays, leaving it empty
+    void take_storage(IncrementalDeque& rhs);
+
+    T* array;                // Current ring
+    size_type capacity;      // Slots in "array", zero or a power of two
+    size_type b;             // Slot of the front element
+    size_type size;          // Number of elements
+    T* old_array;            // Ring being drained, null when not migrating
+    size_type old_capacity;  // Slots in "old_array"
+    size_type old_b;         // Old slot of current slot 0
+    size_type lo;            // Pending slots of "array" are [lo, hi)
+    size_type hi;
+    Allocator alloc;         // Source of both arrays
+
+    // Random-access iterator, holds the IncrementalDeque and a logical position
+    template <bool IsConst>
+    class basic_iterator
+    {
+      using owner_type = std::conditional_t<IsConst, const IncrementalDeque, IncrementalDeque>;
+      friend class IncrementalDeque;
+      friend class basic_iterator<!IsConst>;
+
+    public:
+      using iterator_category = std::random_access_iterator_tag;
+      using value_type        = T;
+      using difference_type   = std::ptrdiff_t;
+      using pointer           = std::conditional_t<IsConst, const T*, T*>;
+      using reference         = std::conditional_t<IsConst, const T&, T&>;
+
+      basic_iterator() : owner(nullptr), pos(0) {}
+
+      // An iterator converts to a const_iterator
+      template <bool C = IsConst, typename = std::enable_if_t<C>>
+      basic_iterator(const basic_iterator<false>& other) : owner(other.owner), pos(other.pos) {}
+
+      reference operator*() const { return owner->element(pos); }
+      pointer operator->() const { return &**this; }
+      reference operator[](difference_type n) const { return *(*this + n); }
+
+      basic_iterator& operator++() { ++pos; return *this; }
+      basic_iterator& operator--() { --pos; return *this; }
+      basic_iterator operator++(int) { basic_iterator old(*this); ++pos; return old; }
+      basic_iterator operator--(int) { basic_iterator old(*this); --pos; return old; }
+      basic_iterator& operator+=(difference_type n) { pos += n; return *this; }
+      basic_iterator& operator-=(difference_type n) { pos -= n; return *this; }
+
+      friend basic_iterator operator+(basic_iterator it, difference_type n) { return it += n; }
+      friend basic_iterator operator+(difference_type n, basic_iterator it) { return it += n; }
+      friend basic_iterator operator-(basic_iterator it, difference_type n) { return it -= n; }
+      friend difference_type operator-(const basic_iterator& l, const basic_iterator& r)
+      {
+        return static_cast<difference_type>(l.pos) - static_cast<difference_type>(r.pos);
+      }
+
+      friend bool operator==(const basic_iterator& l, const basic_iterator& r) { return l.pos == r.pos; }
+      friend bool operator!=(const basic_iterator& l, const basic_iterator& r) { return l.pos != r.pos; }
+      friend bool operator<(const basic_iterator& l, const basic_iterator& r) { return l.pos < r.pos; }
+      friend bool operator>(const basic_iterator& l, const basic_iterator& r) { return l.pos > r.pos; }
+      friend bool operator<=(const basic_iterator& l, const basic_iterator& r) { return l.pos <= r.pos; }
+      friend bool operator>=(const basic_iterator& l, const basic_iterator& r) { return l.pos >= r.pos; }
+
+    private:
+      basic_iterator(owner_type* owner_, size_type pos_) : owner(owner_), pos(pos_) {}
+
+      owner_type* owner; // IncrementalDeque being walked
+      size_type pos;     // Logical index, 0 is the front
+    };
+  };
+
+  // Write the elements as text, "format" picks the separators (text_io.h)
+  template <typename T, typename Allocator, std::size_t Step>
+  std::ostream& write_text(std::ostream& os, const IncrementalDeque<T, Allocator, Step>& d, const TextFormat& format = TextFormat());
+
+  // Stream Operator Overload
+  template <typename T, typename Allocator, std::size_t Step>
+  std::ostream& operator<<(std::ostream& os, const IncrementalDeque<T, Allocator, Step>& d);
+
+  //-----------------------------------------------------------------------------
+  // Public Functions:
+  //-----------------------------------------------------------------------------
+
+  // Default CTOR
+  template <typename T, typename Allocator, std::size_t Step>
+  IncrementalDeque<T, Allocator, Step>::IncrementalDeque() : IncrementalDeque(Allocator()) {}
+
+  //-------------------------------------------------------------------------
+
+  // Allocator CTOR
+  template <typename T, typename Allocator, std::size_t Step>
+  IncrementalDeque<T, Allocator, Step>::IncrementalDeque(const Allocator& alloc_)
+    : array(nullptr), capacity(0), b(0), size(0),
+      old_array(nullptr), old_capacity(0), old_b(0), lo(0), hi(0), alloc(alloc_) {}
+
+  //-------------------------------------------------------------------------
+
+  // Copy CTOR
+  template <typename T, typename Allocator, std::size_t Step>
+  IncrementalDeque<T, Allocator, Step>::IncrementalDeque(const IncrementalDeque& rhs)
+    : IncrementalDeque(alloc_traits::select_on_container_copy_construction(rhs.alloc))
+  {
+    // The delegated CTOR has finished, so a throwing copy runs the DTOR.
+    reserve(rhs.size);
+    rhs.for_each([this](const T& value)
+    {
+      emplace_back(value);
+    });
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Move CTOR
+  template <typename T, typename Allocator, std::size_t Step>
+  IncrementalDeque<T, Allocator, Step>::IncrementalDeque(IncrementalDeque&& rhs) noexcept
+    : IncrementalDeque(std::move(rhs.alloc))
+  {
+    take_storage(rhs);
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Assignment Operator
+  template <typename T, typename Allocator, std::size_t Step>
+  IncrementalDeque<T, Allocator, Step>& IncrementalDeque<T, Allocator, Step>::operator=(const IncrementalDeque& rhs)
+  {
+    if (this != &rhs)
+    {
+      // Build the copy first, so a throwing copy leaves this one untouched.
+      IncrementalDeque local(alloc_traits::propagate_on_container_copy_assignment::value ? rhs.alloc : alloc);
+      local.reserve(rhs.size);
+      rhs.for_each([&local](const T& value)
+      {
+        local.emplace_back(value);
+      });
+
+      destroy_all();
+      if constexpr (alloc_traits::propagate_on_container_copy_assignment::value)
+      {
+        alloc = rhs.alloc;
+      }
+      take_storage(local);
+    }
+    return *this;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Move Assignment Operator
+  template <typename T, typename Allocator, std::size_t Step>
+  IncrementalDeque<T, Allocator, Step>& IncrementalDeque<T, Allocator, Step>::operator=(IncrementalDeque&& rhs)
+    noexcept(alloc_traits::propagate_on_container_move_assignment::value
+          || alloc_traits::is_always_equal::value)
+  {
+    if (this == &rhs)
+    {
+      return *this;
+    }
+
+    if constexpr (alloc_traits::propagate_on_container_move_assignment::value)
+    {
+      destroy_all();
+      alloc = std::move(rhs.alloc);
+      take_storage(rhs);
+    }
+    else if constexpr (alloc_traits::is_always_equal::value)
+    {
+      destroy_all();
+      take_storage(rhs);
+    }
+    else if (alloc == rhs.alloc)
+    {
+      destroy_all();
+      take_storage(rhs);
+    }
+    else
+    {
+      // Our allocator cannot free rhs's arrays, so move the elements across.
+      IncrementalDeque local(alloc);
+      local.reserve(rhs.size);
+      rhs.for_each([&local](T& value)
+      {
+        local.emplace_back(std::move(value));
+      });
+      destroy_all();
+      take_storage(local);
+      rhs.Clear();
+    }
+    return *this;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // DTOR
+  template <typename T, typename Allocator, std::size_t Step>
+  IncrementalDeque<T, Allocator, Step>::~IncrementalDeque()
+  {
+    destroy_all();
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Get the size of the IncrementalDeque
+  template <typename T, typename Allocator, std::size_t Step>
+  typename IncrementalDeque<T, Allocator, Step>::size_type IncrementalDeque<T, Allocator, Step>::Size() const
+  {
+    return size;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Check if the IncrementalDeque is empty
+  template <typename T, typename Allocator, std::size_t Step>
+  bool IncrementalDeque<T, Allocator, Step>::Empty() const
+  {
+    return size == 0;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Clear the IncrementalDeque
+  template <typename T, typename Allocator, std::size_t Step>
+  void IncrementalDeque<T, Allocator, Step>::Clear()
+  {
+    if constexpr (!std::is_trivially_destructible<T>::value)
+    {
+      for (size_type pos = 0; pos < size; ++pos)
+      {
+        alloc_traits::destroy(alloc, &element(pos));
+      }
+    }
+    if (old_array)
+    {
+      alloc_traits::deallocate(alloc, old_array, old_capacity);
+      old_array = nullptr;
+      old_capacity = 0;
+    }
+    b = 0;
+    size = 0;
+    lo = 0;
+    hi = 0;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Get the capacity of the current array
+  template <typename T, typename Allocator, std::size_t Step>
+  typename IncrementalDeque<T, Allocator, Step>::size_type IncrementalDeque<T, Allocator, Step>::Capacity() const
+  {
+    return capacity;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Whether elements are still being moved out of the old array
+  template <typename T, typename Allocator, std::size_t Step>
+  bool IncrementalDeque<T, Allocator, Step>::migrating() const
+  {
+    return old_array != nullptr;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Get the allocator
+  template <typename T, typename Allocator, std::size_t Step>
+  Allocator IncrementalDeque<T, Allocator, Step>::get_allocator() const
+  {
+    return alloc;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Make room for at least "count" elements
+  template <typename T, typename Allocator, std::size_t Step>
+  void IncrementalDeque<T, Allocator, Step>::reserve(size_type count)
+  {
+    if (count > capacity)
+    {
+      relocate(PowerOfTwoWrap::round_capacity(count));
+    }
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Release unused slots
+  template <typename T, typename Allocator, std::size_t Step>
+  void IncrementalDeque<T, Allocator, Step>::shrink_to_fit()
+  {
+    finish_migration();
+    size_type fitted = PowerOfTwoWrap::round_capacity(size);
+    if (fitted < capacity)
+    {
+      relocate(fitted);
+    }
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Push a value to the back of the IncrementalDeque
+  template <typename T, typename Allocator, std::size_t Step>
+  void IncrementalDeque<T, Allocator, Step>::Push_back(const T& val)
+  {
+    emplace_back(val);
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Push a value to the back of the IncrementalDeque
+  template <typename T, typename Allocator, std::size_t Step>
+  void IncrementalDeque<T, Allocator, Step>::Push_back(T&& val)
+  {
+    emplace_back(std::move(val));
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Construct a value in place at the back of the IncrementalDeque
+  template <typename T, typename Allocator, std::size_t Step>
+  template <typename... Args>
+  T& IncrementalDeque<T, Allocator, Step>::emplace_back(Args&&... args)
+  {
+    // Growing only allocates, every element stays where it is.
+    if (size == capacity)
+    {
+      grow();
+    }
+
+    T* added = array + ((b + size) & (capacity - 1));
+    if (old_array)
+    {
+      // The arguments may refer to an element about to migrate,
+      // so build the value before moving anything.
+      T value(std::forward<Args>(args)...);
+      migrate();
+      alloc_traits::construct(alloc, added, std::move(value));
+    }
+    else
+    {
+      alloc_traits::construct(alloc, added, std::forward<Args>(args)...);
+    }
+    size++;
+
+    return *added;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Pop the value from the back of the IncrementalDeque
+  template <typename T, typename Allocator, std::size_t Step>
+  T IncrementalDeque<T, Allocator, Step>::Pop_back()
+  {
+    if (size == 0)
+    {
+      return T();
+    }
+
+    migrate();
+
+    size_type s = (b + size - 1) & (capacity - 1);
+    T* last = locate(s);
+    T removedValue(std::move(*last));
+    alloc_traits::destroy(alloc, last);
+    size--;
+
+    // A pending back element is the last slot of [lo, hi).
+    if (pending(s))
+    {
+      hi--;
+      end_migration_if_done();
+    }
+
+    return removedValue;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Push a value to the front of the IncrementalDeque
+  template <typename T, typename Allocator, std::size_t Step>
+  void IncrementalDeque<T, Allocator, Step>::Push_front(const T& val)
+  {
+    emplace_front(val);
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Push a value to the front of the IncrementalDeque
+  template <typename T, typename Allocator, std::size_t Step>
+  void IncrementalDeque<T, Allocator, Step>::Push_front(T&& val)
+  {
+    emplace_front(std::move(val));
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Construct a value in place at the front of the IncrementalDeque
+  template <typename T, typename Allocator, std::size_t Step>
+  template <typename... Args>
+  T& IncrementalDeque<T, Allocator, Step>::emplace_front(Args&&... args)
+  {
+    if (size == capacity)
+    {
+      grow();
+    }
+
+    size_type new_b = (b - 1) & (capacity - 1);
+    T* added = array + new_b;
+    if (old_array)
+    {
+      T value(std::forward<Args>(args)...);
+      migrate();
+      alloc_traits::construct(alloc, added, std::move(value));
+    }
+    else
+    {
+      alloc_traits::construct(alloc, added, std::forward<Args>(args)...);
+    }
+    b = new_b;
+    size++;
+
+    return *added;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Pop the value from the front of the IncrementalDeque
+  template <typename T, typename Allocator, std::size_t Step>
+  T IncrementalDeque<T, Allocator, Step>::Pop_front()
+  {
+    if (size == 0)
+    {
+      return T();
+    }
+
+    migrate();
+
+    T* first = locate(b);
+    T removedValue(std::move(*first));
+    alloc_traits::destroy(alloc, first);
+
+    // A pending front element is the first slot of [lo, hi).
+    if (pending(b))
+    {
+      lo++;
+      end_migration_if_done();
+    }
+    b = (b + 1) & (capacity - 1);
+    size--;
+
+    return removedValue;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Index Operator with Reference
+  template <typename T, typename Allocator, std::size_t Step>
+  T& IncrementalDeque<T, Allocator, Step>::operator[](size_type pos)
+  {
+    if (pos >= size)
+    {
+      throw std::out_of_range("Index out of range");
+    }
+    return element(pos);
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Index Operator
+  template <typename T, typename Allocator, std::size_t Step>
+  const T& IncrementalDeque<T, Allocator, Step>::operator[](size_type pos) const
+  {
+    if (pos >= size)
+    {
+      throw std::out_of_range("Index out of range");
+    }
+    return element(pos);
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Swap two IncrementalDeques
+  template <typename T, typename Allocator, std::size_t Step>
+  void IncrementalDeque<T, Allocator, Step>::swap(IncrementalDeque& other)
+  {
+    std::swap(array, other.array);
+    std::swap(capacity, other.capacity);
+    std::swap(b, other.b);
+    std::swap(size, other.size);
+    std::swap(old_array, other.old_array);
+    std::swap(old_capacity, other.old_capacity);
+    std::swap(old_b, other.old_b);
+    std::swap(lo, other.lo);
+    std::swap(hi, other.hi);
+
+    // Allocators that do not propagate must already compare equal.
+    if constexpr (alloc_traits::propagate_on_container_swap::value)
+    {
+      using std::swap;
+      swap(alloc, other.alloc);
+    }
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Call f on every element, front to back
+  template <typename T, typename Allocator, std::size_t Step>
+  template <typename F>
+  void IncrementalDeque<T, Allocator, Step>::for_each(F f)
+  {
+    for (size_type pos = 0; pos < size; ++pos)
+    {
+      f(element(pos));
+    }
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Call f on every element, front to back
+  template <typename T, typename Allocator, std::size_t Step>
+  template <typename F>
+  void IncrementalDeque<T, Allocator, Step>::for_each(F f) const
+  {
+    for (size_type pos = 0; pos < size; ++pos)
+    {
+      f(static_cast<const T&>(element(pos)));
+    }
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Write the elements as text
+  template <typename T, typename Allocator, std::size_t Step>
+  std::ostream& write_text(std::ostream& os, const IncrementalDeque<T, Allocator, Step>& d, const TextFormat& format)
+  {
+    return detail::write_elements(os, d, format);
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Stream Operator Overload
+  template <typename T, typename Allocator, std::size_t Step>
+  std::ostream& operator<<(std::ostream& os, const IncrementalDeque<T, Allocator, Step>& d)
+  {
+    // Prints the elements followed by spaces.
+    return write_text(os, d);
+  }
+
+  //-----------------------------------------------------------------------------
+  // Private Functions:
+  //-----------------------------------------------------------------------------
+
+  // Start a ring of twice the capacity, moves no elements
+  template <typename T, typename Allocator, std::size_t Step>
+  void IncrementalDeque<T, Allocator, Step>::grow()
+  {
+    // Step >= 2 ends every migration before the ring can fill again,
+    // this only guards against that invariant being broken.
+    finish_migration();
+
+    size_type new_capacity = capacity ? capacity * 2 : 16;
+    T* new_array = alloc_traits::allocate(alloc, new_capacity);
+
+    if (size == 0)
+    {
+      if (array)
+      {
+        alloc_traits::deallocate(alloc, array, capacity);
+      }
+    }
+    else
+    {
+      // Logical position i of the full ring becomes slot i of the new one.
+      old_array = array;
+      old_capacity = capacity;
+      old_b = b;
+      lo = 0;
+      hi = size;
+    }
+
+    array = new_array;
+    capacity = new_capacity;
+    b = 0;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Move up to Step pending elements into the current array
+  template <typename T, typename Allocator, std::size_t Step>
+  void IncrementalDeque<T, Allocator, Step>::migrate()
+  {
+    for (std::size_t i = 0; i < Step && lo < hi; ++i)
+    {
+      T* from = old_array + ((old_b + lo) & (old_capacity - 1));
+      alloc_traits::construct(alloc, array + lo, std::move_if_noexcept(*from));
+      alloc_traits::destroy(alloc, from);
+      lo++;
+    }
+    end_migration_if_done();
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Move every pending element
+  template <typename T, typename Allocator, std::size_t Step>
+  void IncrementalDeque<T, Allocator, Step>::finish_migration()
+  {
+    while (old_array)
+    {
+      migrate();
+    }
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Free the old array once nothing is pending
+  template <typename T, typename Allocator, std::size_t Step>
+  void IncrementalDeque<T, Allocator, Step>::end_migration_if_done()
+  {
+    if (old_array && lo == hi)
+    {
+      alloc_traits::deallocate(alloc, old_array, old_capacity);
+      old_array = nullptr;
+      old_capacity = 0;
+      lo = 0;
+      hi = 0;
+    }
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Move every element into a fresh array of "new_capacity" slots
+  template <typename T, typename Allocator, std::size_t Step>
+  void IncrementalDeque<T, Allocator, Step>::relocate(size_type new_capacity)
+  {
+    finish_migration();
+
+    T* new_array = new_capacity ? alloc_traits::allocate(alloc, new_capacity) : nullptr;
+    size_type moved = 0;
+    try
+    {
+      for (; moved < size; ++moved)
+      {
+        alloc_traits::construct(alloc, new_array + moved, std::move_if_noexcept(element(moved)));
+      }
+    }
+    catch (...)
+    {
+      while (moved)
+      {
+        alloc_traits::destroy(alloc, new_array + --moved);
+      }
+      alloc_traits::deallocate(alloc, new_array, new_capacity);
+      throw;
+    }
+
+    for (size_type pos = 0; pos < size; ++pos)
+    {
+      alloc_traits::destroy(alloc, &element(pos));
+    }
+    if (array)
+    {
+      alloc_traits::deallocate(alloc, array, capacity);
+    }
+
+    array = new_array;
+    capacity = new_capacity;
+    b = 0;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Destroy every element and free both arrays
+  template <typename T, typename Allocator, std::size_t Step>
+  void IncrementalDeque<T, Allocator, Step>::destroy_all()
+  {
+    Clear();
+    if (array)
+    {
+      alloc_traits::deallocate(alloc, array, capacity);
+      array = nullptr;
+      capacity = 0;
+    }
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Take rhs's arrays, leaving it empty
+  template <typename T, typename Allocator, std::size_t Step>
+  void IncrementalDeque<T, Allocator, Step>::take_storage(IncrementalDeque& rhs)
+  {
+    array = rhs.array;
+    capacity = rhs.capacity;
+    b = rhs.b;
+    size = rhs.size;
+    old_array = rhs.old_array;
+    old_capacity = rhs.old_capacity;
+    old_b = rhs.old_b;
+    lo = rhs.lo;
+    hi = rhs.hi;
+
+    rhs.array = nullptr;
+    rhs.capacity = 0;
+    rhs.b = 0;
+    rhs.size = 0;
+    rhs.old_array = nullptr;
+    rhs.old_capacity = 0;
+    rhs.old_b = 0;
+    rhs.lo = 0;
+    rhs.hi = 0;
+  }
+
+  //-------------------------------------------------------------------------
+
+}
+
+#endif // WRAPBUFFER_INCREMENTAL_DEQUE_H
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,475 @@
+/*!*****************************************************************************
+*\file     mirrored_ring.h
+*\author   Jalin A. Brown
+*\email    JalinBrownWorks@gmail.com
+
+*\brief Description:
+  Double-mapped ("magic") ring buffer: a Deque-style ring whose storage maps
+  the same physical pages twice, back to back, so wrapped data is always
+  contiguous.
+
+  A memfd holding "capacity" elements is mapped at array[0, capacity) and
+  again at array[capacity, 2 * capacity). Writing array[capacity + i] writes
+  array[i], so the live range never has to be split at the wrap point:
+
+    array + b         always points at Size() contiguous elements,
+    array + b + size  always points at Capacity() - Size() free slots.
+
+  Indices still wrap like the Deque's, but never need a division. "b" is
+  kept in [0, capacity) by subtracting capacity when it walks off the end,
+  and everything else is addressed as array + b + i.
+
+  Protocol parsers can read a whole frame in place through data(), and
+  read()/recv() can fill back_space() directly before commit_back().
+
+  Growth copies the live range into a new double mapping with one memcpy.
+  The ring does not shrink on its own. Capacities are rounded up so the
+  mapping is a whole number of pages.
+
+  Linux only (memfd_create), and T must be trivially copyable because
+  elements are moved with memcpy.
+
+******************************************************************************/
+
+#ifndef WRAPBUFFER_MIRRORED_RING_H
+#define WRAPBUFFER_MIRRORED_RING_H
+
+//-----------------------------------------------------------------------------
+// Includes:
+//-----------------------------------------------------------------------------
+
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+#include <sys/mman.h>
+#include <unistd.h>
+
+//-----------------------------------------------------------------------------
+// Public Structures:
+//-----------------------------------------------------------------------------
+
+namespace WrapBuffer {
+
+  template <typename T>
+  class MirroredRing
+  {
+    static_assert(std::is_trivially_copyable<T>::value, "MirroredRing needs a trivially copyable T");
+
+  public:
+    using value_type = T;
+    using size_type  = std::size_t;
+
+    // Default CTOR, maps nothing until the first push
+    MirroredRing();
+
+    // Capacity CTOR, rounded up to a whole number of pages
+    explicit MirroredRing(size_type capacity_);
+
+    MirroredRing(const MirroredRing&) = delete;
+    MirroredRing& operator=(const MirroredRing&) = delete;
+
+    // DTOR
+    ~MirroredRing();
+
+    // Get the size of the ring
+    size_type Size() const;
+
+    // Check if the ring is empty
+    bool Empty() const;
+
+    // Clear the ring
+    void Clear();
+
+    // Get the capacity of the ring
+    size_type Capacity() const;
+
+    // Push a value to the back or front of the ring
+    void Push_back(const T& val);
+    void Push_front(const T& val);
+
+    // Pop the value from the back or front of the ring, T() when empty
+    T Pop_back();
+    T Pop_front();
+
+    // Index Operators
+    T& operator[](size_type pos);
+    const T& operator[](size_type pos) const;
+
+    // All Size() elements, contiguous even when they wrap
+    T* data();
+    const T* data() const;
+
+    // Push "count" values to the back with a single memcpy,
+    // src must not point into this ring
+    void push_back_n(const T* src, size_type count);
+
+    // Drop "count" elements from the front, e.g. after parsing them in place
+    void consume_front(size_type count);
+
+    // Contiguous free slots after the back, Capacity() - Size() of them
+    T* back_space();
+
+    // Make "count" values written into back_space() part of the ring
+    void commit_back(size_type count);
+
+    // Make room for at least "count" elements in total
+    void reserve(size_type count);
+
+  private:
+    // Map "new_capacity" elements twice and move the live range there
+    void reallocate(size_type new_capacity);
+
+    // Double-map a fresh memfd of "bytes" bytes
+    static T* map_mirrored(size_type bytes);
+
+    // Smallest mapping of at least "count" elements, whole pages
+    static size_type mapped_bytes(size_type count);
+
+    size_type b;        // Index of the first element, in [0, capacity)
+    size_type size;     // Number of elements
+    size_type capacity; // Number of elements in one copy of the mapping
+    T* array;           // First of the two mappings, 2 * capacity addressable
+  };
+
+  //-----------------------------------------------------------------------------
+  // Public Functions:
+  //-----------------------------------------------------------------------------
+
+  // Default CTOR, maps nothing until the first push
+  template <typename T>
+  MirroredRing<T>::MirroredRing() : b(0), size(0), capacity(0), array(nullptr) {}
+
+  //-------------------------------------------------------------------------
+
+  // Capacity CTOR, rounded up to a whole number of pages
+  template <typename T>
+  MirroredRing<T>::MirroredRing(size_type capacity_) : MirroredRing()
+  {
+    reserve(capacity_);
+  }
+
+  //-------------------------------------------------------------------------
+
+  // DTOR
+  template <typename T>
+  MirroredRing<T>::~MirroredRing()
+  {
+    if (array)
+    {
+      ::munmap(array, 2 * capacity * sizeof(T));
+    }
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Get the size of the ring
+  template <typename T>
+  typename MirroredRing<T>::size_type MirroredRing<T>::Size() const
+  {
+    return size;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Check if the ring is empty
+  template <typename T>
+  bool MirroredRing<T>::Empty() const
+  {
+    return (size == 0);
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Clear the ring
+  template <typename T>
+  void MirroredRing<T>::Clear()
+  {
+    b = 0;
+    size = 0;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Get the capacity of the ring
+  template <typename T>
+  typename MirroredRing<T>::size_type MirroredRing<T>::Capacity() const
+  {
+    return capacity;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Push a value to the back of the ring
+  template <typename T>
+  void MirroredRing<T>::Push_back(const T& val)
+  {
+    // Copy first, val may live in a mapping that growth replaces.
+    T copy = val;
+    push_back_n(&copy, 1);
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Push a value to the front of the ring
+  template <typename T>
+  void MirroredRing<T>::Push_front(const T& val)
+  {
+    if (size == capacity)
+    {
+      // Copy first, val may live in the mapping about to go away.
+      T copy = val;
+      reserve(size + 1);
+      b = (b ? b : capacity) - 1;
+      array[b] = copy;
+    }
+    else
+    {
+      b = (b ? b : capacity) - 1;
+      array[b] = val;
+    }
+    size++;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Pop the value from the back of the ring
+  template <typename T>
+  T MirroredRing<T>::Pop_back()
+  {
+    if (size == 0)
+    {
+      return T();
+    }
+
+    size--;
+    return array[b + size];
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Pop the value from the front of the ring
+  template <typename T>
+  T MirroredRing<T>::Pop_front()
+  {
+    if (size == 0)
+    {
+      return T();
+    }
+
+    T removedValue = array[b];
+    consume_front(1);
+    return removedValue;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Index Operator with Reference
+  template <typename T>
+  T& MirroredRing<T>::operator[](size_type pos)
+  {
+    if (pos >= size)
+    {
+      throw std::out_of_range("Index out of range");
+    }
+    return array[b + pos];
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Index Operator
+  template <typename T>
+  const T& MirroredRing<T>::operator[](size_type pos) const
+  {
+    if (pos >= size)
+    {
+      throw std::out_of_range("Index out of range");
+    }
+    return array[b + pos];
+  }
+
+  //-------------------------------------------------------------------------
+
+  // All Size() elements, contiguous even when they wrap
+  template <typename T>
+  T* MirroredRing<T>::data()
+  {
+    return array + b;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // All Size() elements, contiguous even when they wrap
+  template <typename T>
+  const T* MirroredRing<T>::data() const
+  {
+    return array + b;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Push "count" values to the back with a single memcpy
+  template <typename T>
+  void MirroredRing<T>::push_back_n(const T* src, size_type count)
+  {
+    if (count == 0)
+    {
+      return;
+    }
+    reserve(size + count);
+    std::memcpy(back_space(), src, count * sizeof(T));
+    commit_back(count);
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Drop "count" elements from the front, e.g. after parsing them in place
+  template <typename T>
+  void MirroredRing<T>::consume_front(size_type count)
+  {
+    if (count > size)
+    {
+      count = size;
+    }
+    b += count;
+    if (b >= capacity)
+    {
+      b -= capacity;
+    }
+    size -= count;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Contiguous free slots after the back, Capacity() - Size() of them
+  template <typename T>
+  T* MirroredRing<T>::back_space()
+  {
+    return array + b + size;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Make "count" values written into back_space() part of the ring
+  template <typename T>
+  void MirroredRing<T>::commit_back(size_type count)
+  {
+    if (count > capacity - size)
+    {
+      throw std::length_error("commit_back past the free space");
+    }
+    size += count;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Make room for at least "count" elements in total
+  template <typename T>
+  void MirroredRing<T>::reserve(size_type count)
+  {
+    if (count > capacity)
+    {
+      // Keep growth geometric like the Deque's doubling.
+      reallocate(count > 2 * capacity ? count : 2 * capacity);
+    }
+  }
+
+  //-------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// Private Functions:
+//-----------------------------------------------------------------------------
+
+  // Map "new_capacity" elements twice and move the live range there
+  template <typename T>
+  void MirroredRing<T>::reallocate(size_type new_capacity)
+  {
+    size_type bytes = mapped_bytes(new_capacity);
+    T* new_array = map_mirrored(bytes);
+
+    // The live range is contiguous, so one copy moves all of it.
+    if (size)
+    {
+      std::memcpy(new_array, array + b, size * sizeof(T));
+    }
+    if (array)
+    {
+      ::munmap(array, 2 * capacity * sizeof(T));
+    }
+
+    array = new_array;
+    b = 0;
+    capacity = bytes / sizeof(T);
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Double-map a fresh memfd of "bytes" bytes
+  template <typename T>
+  T* MirroredRing<T>::map_mirrored(size_type bytes)
+  {
+    int fd = ::memfd_create("WrapBuffer::MirroredRing", MFD_CLOEXEC);
+    if (fd < 0)
+    {
+      throw std::system_error(errno, std::system_category(), "memfd_create");
+    }
+    if (::ftruncate(fd, static_cast<off_t>(bytes)) != 0)
+    {
+      int err = errno;
+      ::close(fd);
+      throw std::system_error(err, std::system_category(), "ftruncate");
+    }
+
+    // Reserve 2 * bytes of address space, then lay the file over both halves.
+    void* base = ::mmap(nullptr, 2 * bytes, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (base == MAP_FAILED)
+    {
+      int err = errno;
+      ::close(fd);
+      throw std::system_error(err, std::system_category(), "mmap");
+    }
+
+    char* lower = static_cast<char*>(base);
+    void* first = ::mmap(lower, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0);
+    void* second = (first == MAP_FAILED) ? MAP_FAILED
+                 : ::mmap(lower + bytes, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0);
+    int err = errno;
+
+    // The mappings keep the memory alive, the descriptor is no longer needed.
+    ::close(fd);
+    if (second == MAP_FAILED)
+    {
+      ::munmap(base, 2 * bytes);
+      throw std::system_error(err, std::system_category(), "mmap");
+    }
+
+    return static_cast<T*>(base);
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Smallest mapping of at least "count" elements, whole pages
+  template <typename T>
+  typename MirroredRing<T>::size_type MirroredRing<T>::mapped_bytes(size_type count)
+  {
+    // The mapping must be a multiple of both the page and the element size.
+    size_type page = static_cast<size_type>(::sysconf(_SC_PAGESIZE));
+    size_type unit = page;
+    while (unit % sizeof(T) != 0)
+    {
+      unit += page;
+    }
+
+    size_type bytes = (count ? count : 1) * sizeof(T);
+    return (bytes + unit - 1) / unit * unit;
+  }
+
+  //-------------------------------------------------------------------------
+
+}
+
+#endif // WRAPBUFFER_MIRRORED_RING_H
+
+//-----------------------------------------------------------------------------
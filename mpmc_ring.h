@@ -0,0 +1,349 @@
+/*!*****************************************************************************
+*\file     mpmc_ring.h
+*\author   Jalin A. Brown
+*\email    JalinBrownWorks@gmail.com
+
+*\brief Description:
+  Bounded multi-producer/multi-consumer ring with per-slot sequence numbers
+  (D. Vyukov's design), laid out like the Deque with a fixed power-of-two
+  capacity and free-running "b" (front) and "e" (back) counters.
+
+  Every slot carries a sequence number that says whose turn it is:
+
+  1) seq == pos:      the slot is free for the producer that claims
+                      position "pos". It claims it with one CAS on "e".
+
+  2) seq == pos + 1:  the slot holds the element pushed at "pos", ready for
+                      the consumer that claims "pos" with one CAS on "b".
+
+  3) After popping, the consumer sets seq = pos + capacity, which is case 1
+     for the producer one lap later.
+
+  Producers only contend with producers on "e" and consumers with consumers
+  on "b". The data handoff happens through the slot's own sequence number,
+  which is stored with release and loaded with acquire. A failed CAS means
+  another thread made progress, so the ring is lock-free.
+
+  try_push and try_pop return false when the ring is full or empty rather
+  than waiting.
+
+  Once a position is claimed, its slot must be handed on or every thread
+  behind it waits forever, so no user code may throw between the CAS and
+  the sequence store:
+
+  1) T must be nothrow move constructible. A value whose construction can
+     throw (a copy of a string, say) is built in a local before the CAS
+     and then moved into the slot.
+
+  2) try_pop releases the slot from a guard's DTOR. If moving the value
+     into "out" throws, the element is dropped and the exception
+     propagates, but the slot still goes back to the producers.
+
+******************************************************************************/
+
+#ifndef WRAPBUFFER_MPMC_RING_H
+#define WRAPBUFFER_MPMC_RING_H
+
+//-----------------------------------------------------------------------------
+// Includes:
+//-----------------------------------------------------------------------------
+
+#include "wrap_policy.h"
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+//-----------------------------------------------------------------------------
+// Public Structures:
+//-----------------------------------------------------------------------------
+
+namespace WrapBuffer {
+
+  template <typename T, typename Allocator = std::allocator<T>>
+  class MpmcRing
+  {
+    static_assert(std::is_nothrow_move_constructible<T>::value,
+                  "MpmcRing moves values into claimed slots, which must not throw");
+
+  public:
+    using value_type     = T;
+    using allocator_type = Allocator;
+    using size_type      = std::size_t;
+
+    // Capacity CTOR, rounded up to a power of two
+    explicit MpmcRing(size_type capacity_, const Allocator& alloc_ = Allocator());
+
+    MpmcRing(const MpmcRing&) = delete;
+    MpmcRing& operator=(const MpmcRing&) = delete;
+
+    // DTOR
+    ~MpmcRing();
+
+    // Add a value to the back, false if the ring is full
+    bool try_push(const T& val);
+    bool try_push(T&& val);
+
+    // Construct a value in place at the back, false if the ring is full
+    template <typename... Args>
+    bool try_emplace(Args&&... args);
+
+    // Move the front value into out, false if the ring is empty
+    bool try_pop(T& out);
+
+    // Number of elements, approximate while other threads are running
+    size_type Size() const;
+
+    // Check if the ring is empty, approximate while other threads are running
+    bool Empty() const;
+
+    // Get the fixed capacity of the ring
+    size_type Capacity() const;
+
+  private:
+    // One element and the sequence number guarding it
+    struct Slot
+    {
+      std::atomic<size_type> seq;
+      alignas(T) unsigned char storage[sizeof(T)];
+
+      // Storage for an element about to be constructed
+      T* raw() { return reinterpret_cast<T*>(storage); }
+
+      // The live element
+      T* value() { return std::launder(raw()); }
+    };
+
+    using slot_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Slot>;
+    using slot_traits    = std::allocator_traits<slot_allocator>;
+    using alloc_traits   = std::allocator_traits<Allocator>;
+
+    // Map a free-running counter onto a slot of the array
+    size_type wrap(size_type x) const { return PowerOfTwoWrap::index(x, capacity); }
+
+    // Claim a position and construct the value in it, which must not throw
+    template <typename... Args>
+    bool publish(Args&&... args);
+
+    // Destroys a popped element and frees its slot, even if the pop throws
+    struct SlotRelease
+    {
+      MpmcRing* ring;
+      Slot* slot;
+      size_type pos;
+
+      ~SlotRelease()
+      {
+        alloc_traits::destroy(ring->alloc, slot->value());
+
+        // Free the slot for the producer one lap ahead.
+        slot->seq.store(pos + ring->capacity, std::memory_order_release);
+      }
+    };
+
+    // Read-only after construction, shared by all threads
+    size_type capacity;                 // Number of slots, a power of two
+    Slot* slots;                        // Slot array
+    Allocator alloc;                    // Constructs and destroys elements
+    slot_allocator slot_alloc;          // Source of the slot array
+
+    alignas(cache_line_size) std::atomic<size_type> e; // Next position producers claim
+    alignas(cache_line_size) std::atomic<size_type> b; // Next position consumers claim
+  };
+
+  //-----------------------------------------------------------------------------
+  // Public Functions:
+  //-----------------------------------------------------------------------------
+
+  // Capacity CTOR, rounded up to a power of two
+  template <typename T, typename Allocator>
+  MpmcRing<T, Allocator>::MpmcRing(size_type capacity_, const Allocator& alloc_)
+    : capacity(PowerOfTwoWrap::round_capacity(capacity_ ? capacity_ : 1)),
+      slots(nullptr), alloc(alloc_), slot_alloc(alloc_), e(0), b(0)
+  {
+    slots = slot_traits::allocate(slot_alloc, capacity);
+
+    // Slot i starts out free for the producer that claims position i.
+    for (size_type i = 0; i < capacity; ++i)
+    {
+      ::new (static_cast<void*>(&slots[i].seq)) std::atomic<size_type>(i);
+    }
+  }
+
+  //-------------------------------------------------------------------------
+
+  // DTOR
+  template <typename T, typename Allocator>
+  MpmcRing<T, Allocator>::~MpmcRing()
+  {
+    size_type last = e.load(std::memory_order_relaxed);
+    for (size_type i = b.load(std::memory_order_relaxed); i != last; ++i)
+    {
+      alloc_traits::destroy(alloc, slots[wrap(i)].value());
+    }
+    slot_traits::deallocate(slot_alloc, slots, capacity);
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Add a value to the back, false if the ring is full
+  template <typename T, typename Allocator>
+  bool MpmcRing<T, Allocator>::try_push(const T& val)
+  {
+    return try_emplace(val);
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Add a value to the back, false if the ring is full
+  template <typename T, typename Allocator>
+  bool MpmcRing<T, Allocator>::try_push(T&& val)
+  {
+    return try_emplace(std::move(val));
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Construct a value in place at the back, false if the ring is full
+  template <typename T, typename Allocator>
+  template <typename... Args>
+  bool MpmcRing<T, Allocator>::try_emplace(Args&&... args)
+  {
+    if constexpr (std::is_nothrow_constructible<T, Args&&...>::value)
+    {
+      return publish(std::forward<Args>(args)...);
+    }
+    else
+    {
+      // Build the value before claiming a position, a throw after the
+      // claim would leave the slot unpublished.
+      T value(std::forward<Args>(args)...);
+      return publish(std::move(value));
+    }
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Move the front value into out, false if the ring is empty
+  template <typename T, typename Allocator>
+  bool MpmcRing<T, Allocator>::try_pop(T& out)
+  {
+    size_type pos = b.load(std::memory_order_relaxed);
+    Slot* slot;
+
+    for (;;)
+    {
+      slot = &slots[wrap(pos)];
+      size_type seq = slot->seq.load(std::memory_order_acquire);
+      std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(seq - (pos + 1));
+
+      if (diff == 0)
+      {
+        // The slot holds the element for "pos": claim it. On failure pos is reloaded.
+        if (b.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+        {
+          break;
+        }
+      }
+      else if (diff < 0)
+      {
+        // Nothing has been pushed at "pos" yet: empty.
+        return false;
+      }
+      else
+      {
+        // Another consumer already took "pos", catch up.
+        pos = b.load(std::memory_order_relaxed);
+      }
+    }
+
+    SlotRelease release{ this, slot, pos };
+    out = std::move(*slot->value());
+    return true;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Number of elements, approximate while other threads are running
+  template <typename T, typename Allocator>
+  typename MpmcRing<T, Allocator>::size_type MpmcRing<T, Allocator>::Size() const
+  {
+    size_type begin = b.load(std::memory_order_acquire);
+    size_type end = e.load(std::memory_order_acquire);
+
+    // The two loads are not one snapshot, so "b" may look ahead of "e".
+    return (end > begin) ? end - begin : 0;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Check if the ring is empty, approximate while other threads are running
+  template <typename T, typename Allocator>
+  bool MpmcRing<T, Allocator>::Empty() const
+  {
+    return Size() == 0;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Get the fixed capacity of the ring
+  template <typename T, typename Allocator>
+  typename MpmcRing<T, Allocator>::size_type MpmcRing<T, Allocator>::Capacity() const
+  {
+    return capacity;
+  }
+
+  //-----------------------------------------------------------------------------
+  // Private Functions:
+  //-----------------------------------------------------------------------------
+
+  // Claim a position and construct the value in it, which must not throw
+  template <typename T, typename Allocator>
+  template <typename... Args>
+  bool MpmcRing<T, Allocator>::publish(Args&&... args)
+  {
+    size_type pos = e.load(std::memory_order_relaxed);
+    Slot* slot;
+
+    for (;;)
+    {
+      slot = &slots[wrap(pos)];
+      size_type seq = slot->seq.load(std::memory_order_acquire);
+      std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(seq - pos);
+
+      if (diff == 0)
+      {
+        // The slot is free for "pos": claim it. On failure pos is reloaded.
+        if (e.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+        {
+          break;
+        }
+      }
+      else if (diff < 0)
+      {
+        // The slot still holds the element from one lap ago: full.
+        return false;
+      }
+      else
+      {
+        // Another producer already took "pos", catch up.
+        pos = e.load(std::memory_order_relaxed);
+      }
+    }
+
+    alloc_traits::construct(alloc, slot->raw(), std::forward<Args>(args)...);
+
+    // Hand the slot to the consumer of "pos".
+    slot->seq.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  //-------------------------------------------------------------------------
+
+}
+
+#endif // WRAPBUFFER_MPMC_RING_H
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,588 @@
+/*!*****************************************************************************
+*\file     ring_buffer.h
+*\author   Jalin A. Brown
+*\email    JalinBrownWorks@gmail.com
+
+*\brief Description:
+  Fixed-capacity ring that keeps the newest N elements, for flight-recorder
+  style telemetry.
+
+  RingBuffer<T, N> uses the Deque's "b" (front) and "e" (back) indices and
+  its wrap step, but never grows. Pushing into a full ring overwrites the
+  oldest element and advances "b" past it:
+
+    array[e] = val;                 // e == b when the ring is full
+    b = (b + 1) & mask;
+    e = (e + 1) & mask;
+
+  The overwrite assigns to the oldest slot instead of destroying and
+  rebuilding it, so an element such as a string can reuse its own buffer.
+
+  The N slots are stored inline, so the ring allocates nothing at all. N is
+  a template argument and must be a power of two, which makes the wrap a
+  mask by a constant.
+
+******************************************************************************/
+
+#ifndef WRAPBUFFER_RING_BUFFER_H
+#define WRAPBUFFER_RING_BUFFER_H
+
+//-----------------------------------------------------------------------------
+// Includes:
+//-----------------------------------------------------------------------------
+
+#include "text_io.h"
+#include <cstddef>
+#include <iterator>
+#include <new>
+#include <ostream>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+//-----------------------------------------------------------------------------
+// Public Structures:
+//-----------------------------------------------------------------------------
+
+namespace WrapBuffer {
+
+  template <typename T, std::size_t N>
+  class RingBuffer
+  {
+    static_assert(N > 0 && (N & (N - 1)) == 0, "RingBuffer capacity must be a power of two");
+
+    template <bool IsConst>
+    class basic_iterator;
+
+  public:
+    using value_type             = T;
+    using size_type              = std::size_t;
+    using difference_type        = std::ptrdiff_t;
+    using reference              = T&;
+    using const_reference        = const T&;
+    using iterator               = basic_iterator<false>;
+    using const_iterator         = basic_iterator<true>;
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    // Default CTOR
+    RingBuffer();
+
+    // Copy CTOR
+    RingBuffer(const RingBuffer& rhs);
+
+    // Move CTOR, moves the elements one by one
+    RingBuffer(RingBuffer&& rhs) noexcept(std::is_nothrow_move_constructible<T>::value);
+
+    // Assignment Operator
+    RingBuffer& operator=(const RingBuffer& rhs);
+
+    // Move Assignment Operator
+    RingBuffer& operator=(RingBuffer&& rhs) noexcept(std::is_nothrow_move_constructible<T>::value);
+
+    // DTOR
+    ~RingBuffer();
+
+    // Get the size of the RingBuffer
+    size_type Size() const;
+
+    // Check if the RingBuffer is empty
+    bool Empty() const;
+
+    // Check if the next push overwrites the oldest element
+    bool Full() const;
+
+    // Get the fixed capacity of the RingBuffer
+    static constexpr size_type Capacity() { return N; }
+
+    // Clear the RingBuffer
+    void Clear();
+
+    // Push a value to the back, overwriting the oldest one when full
+    void Push_back(const T& val);
+    void Push_back(T&& val);
+
+    // Construct a value at the back, overwriting the oldest one when full
+    template <typename... Args>
+    T& emplace_back(Args&&... args);
+
+    // Pop the newest value
+    T Pop_back();
+
+    // Pop the oldest value
+    T Pop_front();
+
+    // Index Operators, 0 is the oldest element
+    T& operator[](size_type pos);
+    const T& operator[](size_type pos) const;
+
+    // Iterators, oldest to newest
+    iterator begin() { return iterator(this, 0); }
+    iterator end() { return iterator(this, size); }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, size); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+    reverse_iterator rbegin() { return reverse_iterator(end()); }
+    reverse_iterator rend() { return reverse_iterator(begin()); }
+    const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+    const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+    // Call f(run, count) on each contiguous run of elements, oldest first
+    template <typename F>
+    void for_each_segment(F f);
+    template <typename F>
+    void for_each_segment(F f) const;
+
+    // Call f on every element, oldest to newest
+    template <typename F>
+    void for_each(F f);
+    template <typename F>
+    void for_each(F f) const;
+
+  private:
+    static constexpr size_type mask = N - 1;
+
+    // Map an index onto a slot of the array
+    static size_type wrap(size_type x) { return x & mask; }
+
+    // Storage of slot "i", for constructing an element in it
+    T* raw_slot(size_type i) { return reinterpret_cast<T*>(storage) + i; }
+
+    // Live element in slot "i"
+    T* slot(size_type i) { return std::launder(raw_slot(i)); }
+    const T* slot(size_type i) const { return std::launder(reinterpret_cast<const T*>(storage) + i); }
+
+    // Element at logical position "pos", unchecked
+    T& element(size_type pos) { return *slot(wrap(b + pos)); }
+    const T& element(size_type pos) const { return *slot(wrap(b + pos)); }
+
+    // Copy or move every element of rhs into this empty RingBuffer
+    template <typename Source>
+    void append_all(Source&& rhs);
+
+    size_type b;     // Slot of the oldest element
+    size_type e;     // Slot after the newest element
+    size_type size;  // Number of elements
+    alignas(T) unsigned char storage[N * sizeof(T)]; // Inline slots, only [b, e) is constructed
+
+    // Random-access iterator, holds the RingBuffer and a logical position
+    template <bool IsConst>
+    class basic_iterator
+    {
+      using owner_type = std::conditional_t<IsConst, const RingBuffer, RingBuffer>;
+      friend class RingBuffer;
+      friend class basic_iterator<!IsConst>;
+
+    public:
+      using iterator_category = std::random_access_iterator_tag;
+      using value_type        = T;
+      using difference_type   = std::ptrdiff_t;
+      using pointer           = std::conditional_t<IsConst, const T*, T*>;
+      using reference         = std::conditional_t<IsConst, const T&, T&>;
+
+      basic_iterator() : owner(nullptr), pos(0) {}
+
+      // An iterator converts to a const_iterator
+      template <bool C = IsConst, typename = std::enable_if_t<C>>
+      basic_iterator(const basic_iterator<false>& other) : owner(other.owner), pos(other.pos) {}
+
+      reference operator*() const { return owner->element(pos); }
+      pointer operator->() const { return &**this; }
+      reference operator[](difference_type n) const { return *(*this + n); }
+
+      basic_iterator& operator++() { ++pos; return *this; }
+      basic_iterator& operator--() { --pos; return *this; }
+      basic_iterator operator++(int) { basic_iterator old(*this); ++pos; return old; }
+      basic_iterator operator--(int) { basic_iterator old(*this); --pos; return old; }
+      basic_iterator& operator+=(difference_type n) { pos += n; return *this; }
+      basic_iterator& operator-=(difference_type n) { pos -= n; return *this; }
+
+      friend basic_iterator operator+(basic_iterator it, difference_type n) { return it += n; }
+      friend basic_iterator operator+(difference_type n, basic_iterator it) { return it += n; }
+      friend basic_iterator operator-(basic_iterator it, difference_type n) { return it -= n; }
+      friend difference_type operator-(const basic_iterator& l, const basic_iterator& r)
+      {
+        return static_cast<difference_type>(l.pos) - static_cast<difference_type>(r.pos);
+      }
+
+      friend bool operator==(const basic_iterator& l, const basic_iterator& r) { return l.pos == r.pos; }
+      friend bool operator!=(const basic_iterator& l, const basic_iterator& r) { return l.pos != r.pos; }
+      friend bool operator<(const basic_iterator& l, const basic_iterator& r) { return l.pos < r.pos; }
+      friend bool operator>(const basic_iterator& l, const basic_iterator& r) { return l.pos > r.pos; }
+      friend bool operator<=(const basic_iterator& l, const basic_iterator& r) { return l.pos <= r.pos; }
+      friend bool operator>=(const basic_iterator& l, const basic_iterator& r) { return l.pos >= r.pos; }
+
+    private:
+      basic_iterator(owner_type* owner_, size_type pos_) : owner(owner_), pos(pos_) {}
+
+      owner_type* owner; // RingBuffer being walked
+      size_type pos;     // Logical index, 0 is the oldest
+    };
+  };
+
+  // Write the elements as text, "format" picks the separators (text_io.h)
+  template <typename T, std::size_t N>
+  std::ostream& write_text(std::ostream& os, const RingBuffer<T, N>& d, const TextFormat& format = TextFormat());
+
+  // Stream Operator Overload
+  template <typename T, std::size_t N>
+  std::ostream& operator<<(std::ostream& os, const RingBuffer<T, N>& d);
+
+  //-----------------------------------------------------------------------------
+  // Public Functions:
+  //-----------------------------------------------------------------------------
+
+  // Default CTOR
+  template <typename T, std::size_t N>
+  RingBuffer<T, N>::RingBuffer() : b(0), e(0), size(0) {}
+
+  //-------------------------------------------------------------------------
+
+  // Copy CTOR
+  template <typename T, std::size_t N>
+  RingBuffer<T, N>::RingBuffer(const RingBuffer& rhs) : RingBuffer()
+  {
+    // The delegated CTOR has finished, so a throwing copy runs the DTOR.
+    append_all(rhs);
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Move CTOR
+  template <typename T, std::size_t N>
+  RingBuffer<T, N>::RingBuffer(RingBuffer&& rhs) noexcept(std::is_nothrow_move_constructible<T>::value)
+    : RingBuffer()
+  {
+    append_all(rhs);
+    rhs.Clear();
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Assignment Operator
+  template <typename T, std::size_t N>
+  RingBuffer<T, N>& RingBuffer<T, N>::operator=(const RingBuffer& rhs)
+  {
+    if (this != &rhs)
+    {
+      Clear();
+      append_all(rhs);
+    }
+    return *this;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Move Assignment Operator
+  template <typename T, std::size_t N>
+  RingBuffer<T, N>& RingBuffer<T, N>::operator=(RingBuffer&& rhs) noexcept(std::is_nothrow_move_constructible<T>::value)
+  {
+    if (this != &rhs)
+    {
+      Clear();
+      append_all(rhs);
+      rhs.Clear();
+    }
+    return *this;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // DTOR
+  template <typename T, std::size_t N>
+  RingBuffer<T, N>::~RingBuffer()
+  {
+    Clear();
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Get the size of the RingBuffer
+  template <typename T, std::size_t N>
+  typename RingBuffer<T, N>::size_type RingBuffer<T, N>::Size() const
+  {
+    return size;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Check if the RingBuffer is empty
+  template <typename T, std::size_t N>
+  bool RingBuffer<T, N>::Empty() const
+  {
+    return size == 0;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Check if the next push overwrites the oldest element
+  template <typename T, std::size_t N>
+  bool RingBuffer<T, N>::Full() const
+  {
+    return size == N;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Clear the RingBuffer
+  template <typename T, std::size_t N>
+  void RingBuffer<T, N>::Clear()
+  {
+    if constexpr (!std::is_trivially_destructible<T>::value)
+    {
+      for (size_type pos = 0; pos < size; ++pos)
+      {
+        element(pos).~T();
+      }
+    }
+    b = 0;
+    e = 0;
+    size = 0;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Push a value to the back, overwriting the oldest one when full
+  template <typename T, std::size_t N>
+  void RingBuffer<T, N>::Push_back(const T& val)
+  {
+    if (size == N)
+    {
+      // Assignment is safe even when val is the oldest element itself.
+      *slot(e) = val;
+      b = wrap(b + 1);
+      e = b;
+      return;
+    }
+    ::new (static_cast<void*>(raw_slot(e))) T(val);
+    e = wrap(e + 1);
+    size++;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Push a value to the back, overwriting the oldest one when full
+  template <typename T, std::size_t N>
+  void RingBuffer<T, N>::Push_back(T&& val)
+  {
+    if (size == N)
+    {
+      *slot(e) = std::move(val);
+      b = wrap(b + 1);
+      e = b;
+      return;
+    }
+    ::new (static_cast<void*>(raw_slot(e))) T(std::move(val));
+    e = wrap(e + 1);
+    size++;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Construct a value at the back, overwriting the oldest one when full
+  template <typename T, std::size_t N>
+  template <typename... Args>
+  T& RingBuffer<T, N>::emplace_back(Args&&... args)
+  {
+    if (size == N)
+    {
+      // The arguments may refer to the oldest element, so build first.
+      T* oldest = slot(e);
+      *oldest = T(std::forward<Args>(args)...);
+      b = wrap(b + 1);
+      e = b;
+      return *oldest;
+    }
+    T* added = ::new (static_cast<void*>(raw_slot(e))) T(std::forward<Args>(args)...);
+    e = wrap(e + 1);
+    size++;
+    return *added;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Pop the newest value
+  template <typename T, std::size_t N>
+  T RingBuffer<T, N>::Pop_back()
+  {
+    if (size == 0)
+    {
+      return T();
+    }
+
+    e = wrap(e - 1);
+    T* last = slot(e);
+    T removedValue(std::move(*last));
+    last->~T();
+    size--;
+
+    return removedValue;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Pop the oldest value
+  template <typename T, std::size_t N>
+  T RingBuffer<T, N>::Pop_front()
+  {
+    if (size == 0)
+    {
+      return T();
+    }
+
+    T* first = slot(b);
+    T removedValue(std::move(*first));
+    first->~T();
+    b = wrap(b + 1);
+    size--;
+
+    return removedValue;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Index Operator with Reference
+  template <typename T, std::size_t N>
+  T& RingBuffer<T, N>::operator[](size_type pos)
+  {
+    if (pos >= size)
+    {
+      throw std::out_of_range("Index out of range");
+    }
+    return element(pos);
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Index Operator
+  template <typename T, std::size_t N>
+  const T& RingBuffer<T, N>::operator[](size_type pos) const
+  {
+    if (pos >= size)
+    {
+      throw std::out_of_range("Index out of range");
+    }
+    return element(pos);
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Call f(run, count) on each contiguous run of elements, oldest first
+  template <typename T, std::size_t N>
+  template <typename F>
+  void RingBuffer<T, N>::for_each_segment(F f)
+  {
+    size_type first = (N - b < size) ? N - b : size;
+    if (first)
+    {
+      f(slot(b), first);
+    }
+    if (size - first)
+    {
+      f(slot(0), size - first);
+    }
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Call f(run, count) on each contiguous run of elements, oldest first
+  template <typename T, std::size_t N>
+  template <typename F>
+  void RingBuffer<T, N>::for_each_segment(F f) const
+  {
+    size_type first = (N - b < size) ? N - b : size;
+    if (first)
+    {
+      f(slot(b), first);
+    }
+    if (size - first)
+    {
+      f(slot(0), size - first);
+    }
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Call f on every element, oldest to newest
+  template <typename T, std::size_t N>
+  template <typename F>
+  void RingBuffer<T, N>::for_each(F f)
+  {
+    for_each_segment([&f](T* run, size_type count)
+    {
+      for (size_type i = 0; i < count; ++i)
+      {
+        f(run[i]);
+      }
+    });
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Call f on every element, oldest to newest
+  template <typename T, std::size_t N>
+  template <typename F>
+  void RingBuffer<T, N>::for_each(F f) const
+  {
+    for_each_segment([&f](const T* run, size_type count)
+    {
+      for (size_type i = 0; i < count; ++i)
+      {
+        f(run[i]);
+      }
+    });
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Write the elements as text
+  template <typename T, std::size_t N>
+  std::ostream& write_text(std::ostream& os, const RingBuffer<T, N>& d, const TextFormat& format)
+  {
+    return detail::write_elements(os, d, format);
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Stream Operator Overload
+  template <typename T, std::size_t N>
+  std::ostream& operator<<(std::ostream& os, const RingBuffer<T, N>& d)
+  {
+    // Prints the elements followed by spaces.
+    return write_text(os, d);
+  }
+
+  //-----------------------------------------------------------------------------
+  // Private Functions:
+  //-----------------------------------------------------------------------------
+
+  // Copy or move every element of rhs into this empty RingBuffer
+  template <typename T, std::size_t N>
+  template <typename Source>
+  void RingBuffer<T, N>::append_all(Source&& rhs)
+  {
+    // Each element is counted as soon as it exists, so a throw leaves a
+    // valid RingBuffer holding the ones copied so far.
+    for (size_type pos = 0; pos < rhs.size; ++pos)
+    {
+      if constexpr (std::is_const<std::remove_reference_t<Source>>::value)
+      {
+        ::new (static_cast<void*>(raw_slot(pos))) T(rhs.element(pos));
+      }
+      else
+      {
+        ::new (static_cast<void*>(raw_slot(pos))) T(std::move(rhs.element(pos)));
+      }
+      size++;
+      e = wrap(size);
+    }
+  }
+
+  //-------------------------------------------------------------------------
+
+}
+
+#endif // WRAPBUFFER_RING_BUFFER_H
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,849 @@
+/*!*****************************************************************************
+*\file     segmented_deque.h
+*\author   Jalin A. Brown
+*\email    JalinBrownWorks@gmail.com
+
+*\brief Description:
+  Segmented variant of the Deque: elements live in fixed-size blocks, and a
+  circular map of block pointers (itself a Deque) keeps the blocks in order.
+
+  Logical position "pos" is element (off + pos) of the concatenated blocks,
+  where "off" is the index of the front element inside the first block:
+
+    block = (off + pos) / BlockSize,  slot = (off + pos) % BlockSize
+
+  BlockSize is a power of two, so both are a shift and a mask.
+
+  1) Push: when the last (or first) block is full, one new block is
+     allocated and its pointer pushed onto the back (or front) of the map.
+     No element is ever copied or moved by growth. The map is the only thing
+     that reallocates, and it holds one pointer per block.
+
+  2) Pop: a block is handed back as soon as its last element leaves, so
+     memory follows the size one block at a time. One emptied block is kept
+     as a spare, so a queue swinging across a block boundary does not
+     allocate and free on every swing.
+
+  Because elements never move, a reference or pointer to an element stays
+  valid until that element is popped or the container is cleared, no matter
+  how much is pushed or popped at either end. Iterators hold a logical
+  position, like the Deque's, so a push or pop at the front shifts what they
+  refer to.
+
+******************************************************************************/
+
+#ifndef WRAPBUFFER_SEGMENTED_DEQUE_H
+#define WRAPBUFFER_SEGMENTED_DEQUE_H
+
+//-----------------------------------------------------------------------------
+// Includes:
+//-----------------------------------------------------------------------------
+
+#include "deque.h"
+#include <cstddef>
+#include <iosfwd>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+//-----------------------------------------------------------------------------
+// Public Structures:
+//-----------------------------------------------------------------------------
+
+namespace WrapBuffer {
+
+  // Elements per block by default: about 4 KiB, a power of two, at least 16
+  template <typename T>
+  constexpr std::size_t segment_block_size()
+  {
+    std::size_t n = 16;
+    while (n * 2 * sizeof(T) <= 4096)
+    {
+      n *= 2;
+    }
+    return n;
+  }
+
+  template <typename T, std::size_t BlockSize = segment_block_size<T>(), typename Allocator = std::allocator<T>>
+  class SegmentedDeque
+  {
+    static_assert(BlockSize != 0 && (BlockSize & (BlockSize - 1)) == 0, "BlockSize must be a power of two");
+
+    template <bool IsConst>
+    class basic_iterator;
+
+    using alloc_traits = std::allocator_traits<Allocator>;
+    using map_type     = Deque<T*, typename alloc_traits::template rebind_alloc<T*>, PowerOfTwoWrap>;
+
+  public:
+    using value_type             = T;
+    using allocator_type         = Allocator;
+    using size_type              = std::size_t;
+    using difference_type        = std::ptrdiff_t;
+    using reference              = T&;
+    using const_reference        = const T&;
+    using iterator               = basic_iterator<false>;
+    using const_iterator         = basic_iterator<true>;
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    static constexpr size_type block_size = BlockSize;
+
+    // Default CTOR
+    SegmentedDeque();
+
+    // Allocator CTOR
+    explicit SegmentedDeque(const Allocator& alloc_);
+
+    // Copy CTOR
+    SegmentedDeque(const SegmentedDeque& rhs);
+
+    // Move CTOR, takes rhs's blocks
+    SegmentedDeque(SegmentedDeque&& rhs) noexcept;
+
+    // Assignment Operator
+    SegmentedDeque& operator=(const SegmentedDeque& rhs);
+
+    // Move Assignment Operator
+    SegmentedDeque& operator=(SegmentedDeque&& rhs)
+      noexcept(alloc_traits::propagate_on_container_move_assignment::value
+            || alloc_traits::is_always_equal::value);
+
+    // DTOR
+    ~SegmentedDeque();
+
+    // Get the size of the SegmentedDeque
+    size_type Size() const;
+
+    // Check if the SegmentedDeque is empty
+    bool Empty() const;
+
+    // Clear the SegmentedDeque, keeps one block as the spare
+    void Clear();
+
+    // Number of element slots in allocated blocks, spare included
+    size_type Capacity() const;
+
+    // Get the allocator
+    Allocator get_allocator() const;
+
+    // Free the spare block and trim the block map
+    void shrink_to_fit();
+
+    // Push a value to the back of the SegmentedDeque
+    void Push_back(const T& val);
+    void Push_back(T&& val);
+
+    // Construct a value in place at the back of the SegmentedDeque
+    template <typename... Args>
+    T& emplace_back(Args&&... args);
+
+    // Pop the value from the back of the SegmentedDeque, T() when empty
+    T Pop_back();
+
+    // Push a value to the front of the SegmentedDeque
+    void Push_front(const T& val);
+    void Push_front(T&& val);
+
+    // Construct a value in place at the front of the SegmentedDeque
+    template <typename... Args>
+    T& emplace_front(Args&&... args);
+
+    // Pop the value from the front of the SegmentedDeque, T() when empty
+    T Pop_front();
+
+    // Index Operators
+    T& operator[](size_type pos);
+    const T& operator[](size_type pos) const;
+
+    // Swap two SegmentedDeques
+    void swap(SegmentedDeque& other);
+
+    // Iterators
+    iterator begin() { return iterator(this, 0); }
+    iterator end() { return iterator(this, size); }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, size); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+    reverse_iterator rbegin() { return reverse_iterator(end()); }
+    reverse_iterator rend() { return reverse_iterator(begin()); }
+    const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+    const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+    // Call f(T* data, size_type count) for each block's run of elements,
+    // front to back
+    template <typename F>
+    void for_each_segment(F f);
+    template <typename F>
+    void for_each_segment(F f) const;
+
+    // Call f on every element, front to back
+    template <typename F>
+    void for_each(F f);
+    template <typename F>
+    void for_each(F f) const;
+
+  private:
+    // Element at logical position "pos", unchecked
+    T& element(size_type pos) const
+    {
+      size_type x = off + pos;
+      return blocks.begin()[x / BlockSize][x & (BlockSize - 1)];
+    }
+
+    // Take the spare block, or allocate one
+    T* acquire_block();
+
+    // Keep a block as the spare, or free it
+    void release_block(T* block);
+
+    // Destroy every element and release every block
+    void destroy_all();
+
+    // Take rhs's blocks, leaving it empty
+    void take_storage(SegmentedDeque& rhs);
+
+    map_type blocks; // Blocks in order, the front element is in blocks[0]
+    size_type off;   // Index of the front element inside blocks[0]
+    size_type size;  // Number of constructed elements
+    T* spare;        // One empty block kept for the next growth, or null
+    Allocator alloc; // Source of the blocks
+
+    // Random-access iterator, holds the SegmentedDeque and a logical position
+    template <bool IsConst>
+    class basic_iterator
+    {
+      using owner_type = std::conditional_t<IsConst, const SegmentedDeque, SegmentedDeque>;
+      friend class SegmentedDeque;
+      friend class basic_iterator<!IsConst>;
+
+    public:
+      using iterator_category = std::random_access_iterator_tag;
+      using value_type        = T;
+      using difference_type   = std::ptrdiff_t;
+      using pointer           = std::conditional_t<IsConst, const T*, T*>;
+      using reference         = std::conditional_t<IsConst, const T&, T&>;
+
+      basic_iterator() : owner(nullptr), pos(0) {}
+
+      // An iterator converts to a const_iterator
+      template <bool C = IsConst, typename = std::enable_if_t<C>>
+      basic_iterator(const basic_iterator<false>& other) : owner(other.owner), pos(other.pos) {}
+
+      reference operator*() const { return owner->element(pos); }
+      pointer operator->() const { return &**this; }
+      reference operator[](difference_type n) const { return *(*this + n); }
+
+      basic_iterator& operator++() { ++pos; return *this; }
+      basic_iterator& operator--() { --pos; return *this; }
+      basic_iterator operator++(int) { basic_iterator old(*this); ++pos; return old; }
+      basic_iterator operator--(int) { basic_iterator old(*this); --pos; return old; }
+      basic_iterator& operator+=(difference_type n) { pos += n; return *this; }
+      basic_iterator& operator-=(difference_type n) { pos -= n; return *this; }
+
+      friend basic_iterator operator+(basic_iterator it, difference_type n) { return it += n; }
+      friend basic_iterator operator+(difference_type n, basic_iterator it) { return it += n; }
+      friend basic_iterator operator-(basic_iterator it, difference_type n) { return it -= n; }
+      friend difference_type operator-(const basic_iterator& l, const basic_iterator& r)
+      {
+        return static_cast<difference_type>(l.pos) - static_cast<difference_type>(r.pos);
+      }
+
+      friend bool operator==(const basic_iterator& l, const basic_iterator& r) { return l.pos == r.pos; }
+      friend bool operator!=(const basic_iterator& l, const basic_iterator& r) { return l.pos != r.pos; }
+      friend bool operator<(const basic_iterator& l, const basic_iterator& r) { return l.pos < r.pos; }
+      friend bool operator>(const basic_iterator& l, const basic_iterator& r) { return l.pos > r.pos; }
+      friend bool operator<=(const basic_iterator& l, const basic_iterator& r) { return l.pos <= r.pos; }
+      friend bool operator>=(const basic_iterator& l, const basic_iterator& r) { return l.pos >= r.pos; }
+
+    private:
+      basic_iterator(owner_type* owner_, size_type pos_) : owner(owner_), pos(pos_) {}
+
+      owner_type* owner; // SegmentedDeque being walked
+      size_type pos;     // Logical index, 0 is the front
+    };
+  };
+
+  // Write the elements as text, "format" picks the separators (text_io.h)
+  template <typename T, std::size_t BlockSize, typename Allocator>
+  std::ostream& write_text(std::ostream& os, const SegmentedDeque<T, BlockSize, Allocator>& d, const TextFormat& format = TextFormat());
+
+  // Stream Operator Overload
+  template <typename T, std::size_t BlockSize, typename Allocator>
+  std::ostream& operator<<(std::ostream& os, const SegmentedDeque<T, BlockSize, Allocator>& d);
+
+  //-----------------------------------------------------------------------------
+  // Public Functions:
+  //-----------------------------------------------------------------------------
+
+  // Default CTOR
+  template <typename T, std::size_t BlockSize, typename Allocator>
+  SegmentedDeque<T, BlockSize, Allocator>::SegmentedDeque() : SegmentedDeque(Allocator()) {}
+
+  //-------------------------------------------------------------------------
+
+  // Allocator CTOR
+  template <typename T, std::size_t BlockSize, typename Allocator>
+  SegmentedDeque<T, BlockSize, Allocator>::SegmentedDeque(const Allocator& alloc_)
+    : blocks(typename map_type::allocator_type(alloc_)), off(0), size(0), spare(nullptr), alloc(alloc_) {}
+
+  //-------------------------------------------------------------------------
+
+  // Copy CTOR
+  template <typename T, std::size_t BlockSize, typename Allocator>
+  SegmentedDeque<T, BlockSize, Allocator>::SegmentedDeque(const SegmentedDeque& rhs)
+    : SegmentedDeque(alloc_traits::select_on_container_copy_construction(rhs.alloc))
+  {
+    // The delegated CTOR has finished, so a throwing copy runs the DTOR.
+    rhs.for_each([this](const T& value)
+    {
+      emplace_back(value);
+    });
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Move CTOR
+  template <typename T, std::size_t BlockSize, typename Allocator>
+  SegmentedDeque<T, BlockSize, Allocator>::SegmentedDeque(SegmentedDeque&& rhs) noexcept
+    : blocks(typename map_type::allocator_type(rhs.alloc)), off(0), size(0), spare(nullptr), alloc(std::move(rhs.alloc))
+  {
+    take_storage(rhs);
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Assignment Operator
+  template <typename T, std::size_t BlockSize, typename Allocator>
+  SegmentedDeque<T, BlockSize, Allocator>& SegmentedDeque<T, BlockSize, Allocator>::operator=(const SegmentedDeque& rhs)
+  {
+    if (this != &rhs)
+    {
+      // Build the copy first, so a throwing copy leaves this one untouched.
+      SegmentedDeque local(alloc_traits::propagate_on_container_copy_assignment::value ? rhs.alloc : alloc);
+      rhs.for_each([&local](const T& value)
+      {
+        local.emplace_back(value);
+      });
+
+      destroy_all();
+      if constexpr (alloc_traits::propagate_on_container_copy_assignment::value)
+      {
+        alloc = rhs.alloc;
+      }
+      take_storage(local);
+    }
+    return *this;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Move Assignment Operator
+  template <typename T, std::size_t BlockSize, typename Allocator>
+  SegmentedDeque<T, BlockSize, Allocator>& SegmentedDeque<T, BlockSize, Allocator>::operator=(SegmentedDeque&& rhs)
+    noexcept(alloc_traits::propagate_on_container_move_assignment::value
+          || alloc_traits::is_always_equal::value)
+  {
+    if (this == &rhs)
+    {
+      return *this;
+    }
+
+    if constexpr (alloc_traits::propagate_on_container_move_assignment::value)
+    {
+      destroy_all();
+      alloc = std::move(rhs.alloc);
+      take_storage(rhs);
+    }
+    else if constexpr (alloc_traits::is_always_equal::value)
+    {
+      destroy_all();
+      take_storage(rhs);
+    }
+    else if (alloc == rhs.alloc)
+    {
+      destroy_all();
+      take_storage(rhs);
+    }
+    else
+    {
+      // Our allocator cannot free rhs's blocks, so move the elements across.
+      SegmentedDeque local(alloc);
+      rhs.for_each([&local](T& value)
+      {
+        local.emplace_back(std::move(value));
+      });
+      destroy_all();
+      take_storage(local);
+      rhs.Clear();
+    }
+    return *this;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // DTOR
+  template <typename T, std::size_t BlockSize, typename Allocator>
+  SegmentedDeque<T, BlockSize, Allocator>::~SegmentedDeque()
+  {
+    destroy_all();
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Get the size of the SegmentedDeque
+  template <typename T, std::size_t BlockSize, typename Allocator>
+  typename SegmentedDeque<T, BlockSize, Allocator>::size_type SegmentedDeque<T, BlockSize, Allocator>::Size() const
+  {
+    return size;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Check if the SegmentedDeque is empty
+  template <typename T, std::size_t BlockSize, typename Allocator>
+  bool SegmentedDeque<T, BlockSize, Allocator>::Empty() const
+  {
+    return size == 0;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Clear the SegmentedDeque
+  template <typename T, std::size_t BlockSize, typename Allocator>
+  void SegmentedDeque<T, BlockSize, Allocator>::Clear()
+  {
+    if constexpr (!std::is_trivially_destructible<T>::value)
+    {
+      for_each([this](T& value)
+      {
+        alloc_traits::destroy(alloc, std::addressof(value));
+      });
+    }
+
+    while (!blocks.Empty())
+    {
+      release_block(blocks.Pop_back());
+    }
+    off = 0;
+    size = 0;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Number of element slots in allocated blocks
+  template <typename T, std::size_t BlockSize, typename Allocator>
+  typename SegmentedDeque<T, BlockSize, Allocator>::size_type SegmentedDeque<T, BlockSize, Allocator>::Capacity() const
+  {
+    return (blocks.Size() + (spare ? 1 : 0)) * BlockSize;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Get the allocator
+  template <typename T, std::size_t BlockSize, typename Allocator>
+  Allocator SegmentedDeque<T, BlockSize, Allocator>::get_allocator() const
+  {
+    return alloc;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Free the spare block and trim the block map
+  template <typename T, std::size_t BlockSize, typename Allocator>
+  void SegmentedDeque<T, BlockSize, Allocator>::shrink_to_fit()
+  {
+    if (spare)
+    {
+      alloc_traits::deallocate(alloc, spare, BlockSize);
+      spare = nullptr;
+    }
+    blocks.shrink_to_fit();
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Push a value to the back of the SegmentedDeque
+  template <typename T, std::size_t BlockSize, typename Allocator>
+  void SegmentedDeque<T, BlockSize, Allocator>::Push_back(const T& val)
+  {
+    emplace_back(val);
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Push a value to the back of the SegmentedDeque
+  template <typename T, std::size_t BlockSize, typename Allocator>
+  void SegmentedDeque<T, BlockSize, Allocator>::Push_back(T&& val)
+  {
+    emplace_back(std::move(val));
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Construct a value in place at the back of the SegmentedDeque
+  template <typename T, std::size_t BlockSize, typename Allocator>
+  template <typename... Args>
+  T& SegmentedDeque<T, BlockSize, Allocator>::emplace_back(Args&&... args)
+  {
+    size_type x = off + size;
+
+    // Elements never move, so the arguments stay valid even if they refer
+    // to an element of this SegmentedDeque.
+    if (x == blocks.Size() * BlockSize)
+    {
+      // The last block is full (or there is none): start a new one.
+      T* block = acquire_block();
+      try
+      {
+        alloc_traits::construct(alloc, block, std::forward<Args>(args)...);
+      }
+      catch (...)
+      {
+        release_block(block);
+        throw;
+      }
+
+      try
+      {
+        blocks.Push_back(block);
+      }
+      catch (...)
+      {
+        alloc_traits::destroy(alloc, block);
+        release_block(block);
+        throw;
+      }
+
+      size++;
+      return *block;
+    }
+
+    T* added = blocks.begin()[x / BlockSize] + (x & (BlockSize - 1));
+    alloc_traits::construct(alloc, added, std::forward<Args>(args)...);
+    size++;
+    return *added;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Pop the value from the back of the SegmentedDeque
+  template <typename T, std::size_t BlockSize, typename Allocator>
+  T SegmentedDeque<T, BlockSize, Allocator>::Pop_back()
+  {
+    if (size == 0)
+    {
+      return T();
+    }
+
+    size_type x = off + size - 1;
+    T* last = blocks.begin()[x / BlockSize] + (x & (BlockSize - 1));
+    T removedValue(std::move(*last));
+    alloc_traits::destroy(alloc, last);
+    size--;
+
+    // Hand the last block back once it has no elements left.
+    if (size == 0 || (x & (BlockSize - 1)) == 0)
+    {
+      release_block(blocks.Pop_back());
+    }
+    if (size == 0)
+    {
+      off = 0;
+    }
+
+    return removedValue;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Push a value to the front of the SegmentedDeque
+  template <typename T, std::size_t BlockSize, typename Allocator>
+  void SegmentedDeque<T, BlockSize, Allocator>::Push_front(const T& val)
+  {
+    emplace_front(val);
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Push a value to the front of the SegmentedDeque
+  template <typename T, std::size_t BlockSize, typename Allocator>
+  void SegmentedDeque<T, BlockSize, Allocator>::Push_front(T&& val)
+  {
+    emplace_front(std::move(val));
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Construct a value in place at the front of the SegmentedDeque
+  template <typename T, std::size_t BlockSize, typename Allocator>
+  template <typename... Args>
+  T& SegmentedDeque<T, BlockSize, Allocator>::emplace_front(Args&&... args)
+  {
+    if (off == 0)
+    {
+      // The first block is full (or there is none): start a new one and
+      // fill it from its end, leaving room for further pushes to the front.
+      T* block = acquire_block();
+      T* added = block + (BlockSize - 1);
+      try
+      {
+        alloc_traits::construct(alloc, added, std::forward<Args>(args)...);
+      }
+      catch (...)
+      {
+        release_block(block);
+        throw;
+      }
+
+      try
+      {
+        blocks.Push_front(block);
+      }
+      catch (...)
+      {
+        alloc_traits::destroy(alloc, added);
+        release_block(block);
+        throw;
+      }
+
+      off = BlockSize - 1;
+      size++;
+      return *added;
+    }
+
+    T* added = blocks.begin()[0] + (off - 1);
+    alloc_traits::construct(alloc, added, std::forward<Args>(args)...);
+    off--;
+    size++;
+    return *added;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Pop the value from the front of the SegmentedDeque
+  template <typename T, std::size_t BlockSize, typename Allocator>
+  T SegmentedDeque<T, BlockSize, Allocator>::Pop_front()
+  {
+    if (size == 0)
+    {
+      return T();
+    }
+
+    T* first = blocks.begin()[0] + off;
+    T removedValue(std::move(*first));
+    alloc_traits::destroy(alloc, first);
+    off++;
+    size--;
+
+    // Hand the first block back once it has no elements left.
+    if (size == 0 || off == BlockSize)
+    {
+      release_block(blocks.Pop_front());
+      off = 0;
+    }
+
+    return removedValue;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Index Operator with Reference
+  template <typename T, std::size_t BlockSize, typename Allocator>
+  T& SegmentedDeque<T, BlockSize, Allocator>::operator[](size_type pos)
+  {
+    if (pos >= size)
+    {
+      throw std::out_of_range("Index out of range");
+    }
+    return element(pos);
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Index Operator
+  template <typename T, std::size_t BlockSize, typename Allocator>
+  const T& SegmentedDeque<T, BlockSize, Allocator>::operator[](size_type pos) const
+  {
+    if (pos >= size)
+    {
+      throw std::out_of_range("Index out of range");
+    }
+    return element(pos);
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Swap two SegmentedDeques
+  template <typename T, std::size_t BlockSize, typename Allocator>
+  void SegmentedDeque<T, BlockSize, Allocator>::swap(SegmentedDeque& other)
+  {
+    blocks.swap(other.blocks);
+    std::swap(off, other.off);
+    std::swap(size, other.size);
+    std::swap(spare, other.spare);
+
+    // Allocators that do not propagate must already compare equal.
+    if constexpr (alloc_traits::propagate_on_container_swap::value)
+    {
+      using std::swap;
+      swap(alloc, other.alloc);
+    }
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Call f(T* data, size_type count) for each block's run of elements
+  template <typename T, std::size_t BlockSize, typename Allocator>
+  template <typename F>
+  void SegmentedDeque<T, BlockSize, Allocator>::for_each_segment(F f)
+  {
+    size_type first = off;
+    size_type left = size;
+    for (auto it = blocks.begin(); left != 0; ++it)
+    {
+      size_type count = (BlockSize - first < left) ? BlockSize - first : left;
+      f(*it + first, count);
+      left -= count;
+      first = 0;
+    }
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Call f(const T* data, size_type count) for each block's run of elements
+  template <typename T, std::size_t BlockSize, typename Allocator>
+  template <typename F>
+  void SegmentedDeque<T, BlockSize, Allocator>::for_each_segment(F f) const
+  {
+    size_type first = off;
+    size_type left = size;
+    for (auto it = blocks.begin(); left != 0; ++it)
+    {
+      size_type count = (BlockSize - first < left) ? BlockSize - first : left;
+      f(static_cast<const T*>(*it + first), count);
+      left -= count;
+      first = 0;
+    }
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Call f on every element, front to back
+  template <typename T, std::size_t BlockSize, typename Allocator>
+  template <typename F>
+  void SegmentedDeque<T, BlockSize, Allocator>::for_each(F f)
+  {
+    for_each_segment([&f](T* data, size_type count)
+    {
+      for (size_type i = 0; i < count; ++i)
+      {
+        f(data[i]);
+      }
+    });
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Call f on every element, front to back
+  template <typename T, std::size_t BlockSize, typename Allocator>
+  template <typename F>
+  void SegmentedDeque<T, BlockSize, Allocator>::for_each(F f) const
+  {
+    for_each_segment([&f](const T* data, size_type count)
+    {
+      for (size_type i = 0; i < count; ++i)
+      {
+        f(data[i]);
+      }
+    });
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Write the elements as text
+  template <typename T, std::size_t BlockSize, typename Allocator>
+  std::ostream& write_text(std::ostream& os, const SegmentedDeque<T, BlockSize, Allocator>& d, const TextFormat& format)
+  {
+    return detail::write_elements(os, d, format);
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Stream Operator Overload
+  template <typename T, std::size_t BlockSize, typename Allocator>
+  std::ostream& operator<<(std::ostream& os, const SegmentedDeque<T, BlockSize, Allocator>& d)
+  {
+    // Prints the elements followed by spaces.
+    return write_text(os, d);
+  }
+
+  //-----------------------------------------------------------------------------
+  // Private Functions:
+  //-----------------------------------------------------------------------------
+
+  // Take the spare block, or allocate one
+  template <typename T, std::size_t BlockSize, typename Allocator>
+  T* SegmentedDeque<T, BlockSize, Allocator>::acquire_block()
+  {
+    if (spare)
+    {
+      T* block = spare;
+      spare = nullptr;
+      return block;
+    }
+    return alloc_traits::allocate(alloc, BlockSize);
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Keep a block as the spare, or free it
+  template <typename T, std::size_t BlockSize, typename Allocator>
+  void SegmentedDeque<T, BlockSize, Allocator>::release_block(T* block)
+  {
+    if (spare)
+    {
+      alloc_traits::deallocate(alloc, block, BlockSize);
+    }
+    else
+    {
+      spare = block;
+    }
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Destroy every element and release every block
+  template <typename T, std::size_t BlockSize, typename Allocator>
+  void SegmentedDeque<T, BlockSize, Allocator>::destroy_all()
+  {
+    Clear();
+    shrink_to_fit();
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Take rhs's blocks, leaving it empty
+  template <typename T, std::size_t BlockSize, typename Allocator>
+  void SegmentedDeque<T, BlockSize, Allocator>::take_storage(SegmentedDeque& rhs)
+  {
+    blocks = std::move(rhs.blocks);
+    off = rhs.off;
+    size = rhs.size;
+    spare = rhs.spare;
+
+    rhs.off = 0;
+    rhs.size = 0;
+    rhs.spare = nullptr;
+  }
+
+  //-------------------------------------------------------------------------
+
+}
+
+#endif // WRAPBUFFER_SEGMENTED_DEQUE_H
+
+//-----------------------------------------------------------------------------
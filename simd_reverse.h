@@ -0,0 +1,341 @@
+/*!*****************************************************************************
+*\file     simd_reverse.h
+*\author   Jalin A. Brown
+*\email    JalinBrownWorks@gmail.com
+
+*\brief Description:
+  Vectorized kernels behind Deque::reverse() and Deque::operator~.
+
+  Both kernels work on the ring directly. Logical position "pos" lives in
+  slot b + pos, minus capacity once that passes the end of the array, so no
+  division is needed.
+
+  1) reverse_ring: swaps the block of W elements at the left end with the
+     block of W elements at the right end, each reversed with one shuffle,
+     and moves both ends inward by W. A block is only loaded whole when it
+     does not cross the end of the array. When one does, a single pair is
+     swapped instead, which moves the block past the wrap point within W
+     steps. The middle that is left when fewer than 2W elements remain is
+     swapped one pair at a time.
+
+  2) reverse_copy_ring: writes the ring, back to front, into a contiguous
+     destination, one reversed block per store, again stepping one element
+     at a time across the wrap point.
+
+  Element sizes of 2, 4 and 8 bytes of trivially copyable types use SSE2
+  (16-byte blocks) or, when the CPU reports it at run time, AVX2 (32-byte
+  blocks). Everything else, and every non-x86 build, uses the scalar kernel.
+
+******************************************************************************/
+
+#ifndef WRAPBUFFER_SIMD_REVERSE_H
+#define WRAPBUFFER_SIMD_REVERSE_H
+
+//-----------------------------------------------------------------------------
+// Includes:
+//-----------------------------------------------------------------------------
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__) && defined(__SSE2__)
+#define WRAPBUFFER_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+//-----------------------------------------------------------------------------
+// Private Structures:
+//-----------------------------------------------------------------------------
+
+namespace WrapBuffer {
+  namespace detail {
+
+    // Slot of logical position "pos" in a ring that starts at slot "b"
+    inline std::size_t ring_slot(std::size_t b, std::size_t pos, std::size_t capacity)
+    {
+      std::size_t x = b + pos;
+      return (x >= capacity) ? x - capacity : x;
+    }
+
+    //-------------------------------------------------------------------------
+
+    // One element at a time, valid for any T
+    struct ScalarKernel
+    {
+      static constexpr std::size_t lanes(std::size_t) { return 1; }
+
+      template <typename T>
+      static void swap_reversed(T* l, T* r)
+      {
+        using std::swap;
+        swap(*l, *r);
+      }
+
+      template <typename T>
+      static void copy_reversed(T* dst, const T* src)
+      {
+        *dst = *src;
+      }
+    };
+
+#ifdef WRAPBUFFER_X86_SIMD
+
+    //-------------------------------------------------------------------------
+
+    // 16-byte blocks, SSE2 is part of every x86-64 target
+    struct Sse2Kernel
+    {
+      static constexpr std::size_t lanes(std::size_t bytes) { return 16 / bytes; }
+
+      template <typename T>
+      static __m128i flip(__m128i v)
+      {
+        if constexpr (sizeof(T) == 8)
+        {
+          return _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2));
+        }
+        else if constexpr (sizeof(T) == 4)
+        {
+          return _mm_shuffle_epi32(v, _MM_SHUFFLE(0, 1, 2, 3));
+        }
+        else
+        {
+          v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+          v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+          return _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2));
+        }
+      }
+
+      template <typename T>
+      static void swap_reversed(T* l, T* r)
+      {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(l));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(r));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(l), flip<T>(b));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(r), flip<T>(a));
+      }
+
+      template <typename T>
+      static void copy_reversed(T* dst, const T* src)
+      {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), flip<T>(a));
+      }
+    };
+
+    //-------------------------------------------------------------------------
+
+    // 32-byte blocks, only called after the CPU reports AVX2
+    struct Avx2Kernel
+    {
+      static constexpr std::size_t lanes(std::size_t bytes) { return 32 / bytes; }
+
+      template <typename T>
+      __attribute__((target("avx2"))) static __m256i flip(__m256i v)
+      {
+        if constexpr (sizeof(T) == 8)
+        {
+          return _mm256_permute4x64_epi64(v, _MM_SHUFFLE(0, 1, 2, 3));
+        }
+        else if constexpr (sizeof(T) == 4)
+        {
+          return _mm256_permutevar8x32_epi32(v, _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+        }
+        else
+        {
+          // Reverse the halfwords inside each 128-bit lane, then swap the lanes.
+          const __m256i halves = _mm256_setr_epi8(14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1,
+                                                  14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1);
+          return _mm256_permute4x64_epi64(_mm256_shuffle_epi8(v, halves), _MM_SHUFFLE(1, 0, 3, 2));
+        }
+      }
+
+      template <typename T>
+      __attribute__((target("avx2"))) static void swap_reversed(T* l, T* r)
+      {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(l));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(r));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(l), flip<T>(b));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(r), flip<T>(a));
+      }
+
+      template <typename T>
+      __attribute__((target("avx2"))) static void copy_reversed(T* dst, const T* src)
+      {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), flip<T>(a));
+      }
+    };
+
+#endif
+
+    //-------------------------------------------------------------------------
+
+    // Reverse the "size" elements of the ring in place with kernel K
+    template <typename K, typename T>
+    inline void reverse_ring_with(T* array, std::size_t capacity, std::size_t b, std::size_t size)
+    {
+      using std::swap;
+      const std::size_t w = K::lanes(sizeof(T));
+
+      // [i, j) is the part of the ring still to be reversed.
+      std::size_t i = 0;
+      std::size_t j = size;
+
+      while (j - i >= 2 * w)
+      {
+        std::size_t p = ring_slot(b, i, capacity);
+        std::size_t q = ring_slot(b, j - w, capacity);
+        if (p + w <= capacity && q + w <= capacity)
+        {
+          K::swap_reversed(array + p, array + q);
+          i += w;
+          j -= w;
+        }
+        else
+        {
+          // A block crosses the end of the array: step one pair past it.
+          swap(array[p], array[ring_slot(b, j - 1, capacity)]);
+          i++;
+          j--;
+        }
+      }
+
+      while (j - i >= 2)
+      {
+        swap(array[ring_slot(b, i, capacity)], array[ring_slot(b, j - 1, capacity)]);
+        i++;
+        j--;
+      }
+    }
+
+    //-------------------------------------------------------------------------
+
+    // Write the ring back to front into dst[0, size) with kernel K
+    template <typename K, typename T>
+    inline void reverse_copy_ring_with(const T* array, std::size_t capacity, std::size_t b, std::size_t size, T* dst)
+    {
+      const std::size_t w = K::lanes(sizeof(T));
+
+      // dst[k] receives logical element size - 1 - k.
+      std::size_t k = 0;
+      while (size - k >= w)
+      {
+        std::size_t q = ring_slot(b, size - k - w, capacity);
+        if (q + w <= capacity)
+        {
+          K::copy_reversed(dst + k, array + q);
+          k += w;
+        }
+        else
+        {
+          dst[k] = array[ring_slot(b, size - 1 - k, capacity)];
+          k++;
+        }
+      }
+
+      for (; k < size; ++k)
+      {
+        dst[k] = array[ring_slot(b, size - 1 - k, capacity)];
+      }
+    }
+
+    //-------------------------------------------------------------------------
+
+    // Whether T can be moved around by the vector kernels
+    template <typename T>
+    constexpr bool simd_reversible = std::is_trivially_copyable<T>::value
+                                  && (sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8);
+
+#ifdef WRAPBUFFER_X86_SIMD
+
+    //-------------------------------------------------------------------------
+
+    // Whether the running CPU supports AVX2, checked once
+    inline bool cpu_has_avx2()
+    {
+      static const bool has = __builtin_cpu_supports("avx2");
+      return has;
+    }
+
+    // Entry points compiled for each instruction set. "flatten" inlines the
+    // kernels into the loops so each block is a handful of instructions.
+    template <typename T>
+    __attribute__((flatten)) void reverse_ring_sse2(T* array, std::size_t capacity, std::size_t b, std::size_t size)
+    {
+      reverse_ring_with<Sse2Kernel>(array, capacity, b, size);
+    }
+
+    template <typename T>
+    __attribute__((target("avx2"), flatten)) void reverse_ring_avx2(T* array, std::size_t capacity, std::size_t b, std::size_t size)
+    {
+      reverse_ring_with<Avx2Kernel>(array, capacity, b, size);
+    }
+
+    template <typename T>
+    __attribute__((flatten)) void reverse_copy_ring_sse2(const T* array, std::size_t capacity, std::size_t b, std::size_t size, T* dst)
+    {
+      reverse_copy_ring_with<Sse2Kernel>(array, capacity, b, size, dst);
+    }
+
+    template <typename T>
+    __attribute__((target("avx2"), flatten)) void reverse_copy_ring_avx2(const T* array, std::size_t capacity, std::size_t b, std::size_t size, T* dst)
+    {
+      reverse_copy_ring_with<Avx2Kernel>(array, capacity, b, size, dst);
+    }
+
+#endif
+
+    //-------------------------------------------------------------------------
+
+    // Reverse the "size" elements of the ring in place
+    template <typename T>
+    void reverse_ring(T* array, std::size_t capacity, std::size_t b, std::size_t size)
+    {
+#ifdef WRAPBUFFER_X86_SIMD
+      if constexpr (simd_reversible<T>)
+      {
+        if (cpu_has_avx2())
+        {
+          reverse_ring_avx2(array, capacity, b, size);
+        }
+        else
+        {
+          reverse_ring_sse2(array, capacity, b, size);
+        }
+        return;
+      }
+#endif
+      reverse_ring_with<ScalarKernel>(array, capacity, b, size);
+    }
+
+    //-------------------------------------------------------------------------
+
+    // Write the ring back to front into dst[0, size), T trivially copyable
+    template <typename T>
+    void reverse_copy_ring(const T* array, std::size_t capacity, std::size_t b, std::size_t size, T* dst)
+    {
+#ifdef WRAPBUFFER_X86_SIMD
+      if constexpr (simd_reversible<T>)
+      {
+        if (cpu_has_avx2())
+        {
+          reverse_copy_ring_avx2(array, capacity, b, size, dst);
+        }
+        else
+        {
+          reverse_copy_ring_sse2(array, capacity, b, size, dst);
+        }
+        return;
+      }
+#endif
+      reverse_copy_ring_with<ScalarKernel>(array, capacity, b, size, dst);
+    }
+
+  }
+}
+
+#endif // WRAPBUFFER_SIMD_REVERSE_H
+
+//-----------------------------------------------------------------------------
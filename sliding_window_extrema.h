@@ -0,0 +1,239 @@
+/*!*****************************************************************************
+*\file     sliding_window_extrema.h
+*\author   Jalin A. Brown
+*\email    JalinBrownWorks@gmail.com
+
+*\brief Description:
+  Running minimum and maximum of the last N samples of a stream, in
+  amortized O(1) per sample instead of an O(N) scan per query.
+
+  Each extreme is kept in a monotonic Deque of (sequence number, value)
+  entries. For the minimum, values increase from front to back:
+
+  1) push(value): entries at the back that are not smaller than the new
+     value can never be the minimum again, because the new value is at
+     least as small and expires later. They are popped, then the new entry
+     is pushed. Every entry is pushed and popped once, so this is amortized
+     O(1).
+
+  2) expire_older_than(n): the window keeps the last n samples. Entries at
+     the front whose sequence number has fallen out of it are popped.
+
+  3) min(): the front entry, O(1).
+
+  The maximum is the same with the comparison flipped. Both queues only
+  ever hold samples from the window, so they never exceed its length, and
+  automatic shrinking is turned off so a steady window never reallocates.
+
+******************************************************************************/
+
+#ifndef WRAPBUFFER_SLIDING_WINDOW_EXTREMA_H
+#define WRAPBUFFER_SLIDING_WINDOW_EXTREMA_H
+
+//-----------------------------------------------------------------------------
+// Includes:
+//-----------------------------------------------------------------------------
+
+#include "deque.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+
+//-----------------------------------------------------------------------------
+// Public Structures:
+//-----------------------------------------------------------------------------
+
+namespace WrapBuffer {
+
+  template <typename T, typename Compare = std::less<T>, typename Allocator = std::allocator<T>>
+  class SlidingWindowExtrema
+  {
+  public:
+    using value_type    = T;
+    using size_type     = std::size_t;
+    using sequence_type = std::uint64_t;
+
+    // Default CTOR
+    explicit SlidingWindowExtrema(const Compare& comp_ = Compare(), const Allocator& alloc_ = Allocator());
+
+    // Add a sample to the window, returns its sequence number (0, 1, 2, ...)
+    sequence_type push(const T& value);
+
+    // Keep only the last "n" samples
+    void expire_older_than(size_type n);
+
+    // Smallest and largest sample in the window, throws if it is empty
+    const T& min() const;
+    const T& max() const;
+
+    // Number of samples in the window
+    size_type Size() const;
+
+    // Check if the window is empty
+    bool Empty() const;
+
+    // Drop every sample, sequence numbers keep counting
+    void Clear();
+
+  private:
+    // A sample still able to become an extreme
+    struct Entry
+    {
+      sequence_type seq; // Sequence number of the sample
+      T value;           // The sample
+    };
+
+    using entry_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Entry>;
+    using queue_type      = Deque<Entry, entry_allocator, PowerOfTwoWrap>;
+
+    // Push "value" onto a monotonic queue, "before" orders the extreme first
+    template <typename Before>
+    static void push_monotonic(queue_type& queue, sequence_type seq, const T& value, Before before);
+
+    // Pop entries older than "oldest" from the front of a queue
+    static void expire(queue_type& queue, sequence_type oldest);
+
+    Compare comp;         // Orders samples, std::less for min/max
+    queue_type mins;      // Increasing under comp, front is the minimum
+    queue_type maxs;      // Decreasing under comp, front is the maximum
+    sequence_type first;  // Sequence number of the oldest sample in the window
+    sequence_type next;   // Sequence number of the next sample
+  };
+
+  //-----------------------------------------------------------------------------
+  // Public Functions:
+  //-----------------------------------------------------------------------------
+
+  // Default CTOR
+  template <typename T, typename Compare, typename Allocator>
+  SlidingWindowExtrema<T, Compare, Allocator>::SlidingWindowExtrema(const Compare& comp_, const Allocator& alloc_)
+    : comp(comp_),
+      mins(ShrinkPolicy{ 0, 4, false }, entry_allocator(alloc_)),
+      maxs(ShrinkPolicy{ 0, 4, false }, entry_allocator(alloc_)),
+      first(0),
+      next(0)
+  {
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Add a sample to the window, returns its sequence number
+  template <typename T, typename Compare, typename Allocator>
+  typename SlidingWindowExtrema<T, Compare, Allocator>::sequence_type SlidingWindowExtrema<T, Compare, Allocator>::push(const T& value)
+  {
+    sequence_type seq = next++;
+    push_monotonic(mins, seq, value, [this](const T& l, const T& r) { return comp(l, r); });
+    push_monotonic(maxs, seq, value, [this](const T& l, const T& r) { return comp(r, l); });
+    return seq;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Keep only the last "n" samples
+  template <typename T, typename Compare, typename Allocator>
+  void SlidingWindowExtrema<T, Compare, Allocator>::expire_older_than(size_type n)
+  {
+    if (next - first > n)
+    {
+      first = next - n;
+      expire(mins, first);
+      expire(maxs, first);
+    }
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Smallest sample in the window
+  template <typename T, typename Compare, typename Allocator>
+  const T& SlidingWindowExtrema<T, Compare, Allocator>::min() const
+  {
+    if (mins.Empty())
+    {
+      throw std::out_of_range("Window is empty");
+    }
+    return mins.begin()->value;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Largest sample in the window
+  template <typename T, typename Compare, typename Allocator>
+  const T& SlidingWindowExtrema<T, Compare, Allocator>::max() const
+  {
+    if (maxs.Empty())
+    {
+      throw std::out_of_range("Window is empty");
+    }
+    return maxs.begin()->value;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Number of samples in the window
+  template <typename T, typename Compare, typename Allocator>
+  typename SlidingWindowExtrema<T, Compare, Allocator>::size_type SlidingWindowExtrema<T, Compare, Allocator>::Size() const
+  {
+    return static_cast<size_type>(next - first);
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Check if the window is empty
+  template <typename T, typename Compare, typename Allocator>
+  bool SlidingWindowExtrema<T, Compare, Allocator>::Empty() const
+  {
+    return next == first;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Drop every sample, sequence numbers keep counting
+  template <typename T, typename Compare, typename Allocator>
+  void SlidingWindowExtrema<T, Compare, Allocator>::Clear()
+  {
+    mins.Clear();
+    maxs.Clear();
+    first = next;
+  }
+
+  //-------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// Private Functions:
+//-----------------------------------------------------------------------------
+
+  // Push "value" onto a monotonic queue, "before" orders the extreme first
+  template <typename T, typename Compare, typename Allocator>
+  template <typename Before>
+  void SlidingWindowExtrema<T, Compare, Allocator>::push_monotonic(queue_type& queue, sequence_type seq, const T& value, Before before)
+  {
+    // An older entry that does not come strictly before the new value is
+    // dominated by it for the rest of its life.
+    while (!queue.Empty() && !before((queue.end() - 1)->value, value))
+    {
+      queue.Pop_back();
+    }
+    queue.emplace_back(Entry{ seq, value });
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Pop entries older than "oldest" from the front of a queue
+  template <typename T, typename Compare, typename Allocator>
+  void SlidingWindowExtrema<T, Compare, Allocator>::expire(queue_type& queue, sequence_type oldest)
+  {
+    while (!queue.Empty() && queue.begin()->seq < oldest)
+    {
+      queue.Pop_front();
+    }
+  }
+
+  //-------------------------------------------------------------------------
+
+}
+
+#endif // WRAPBUFFER_SLIDING_WINDOW_EXTREMA_H
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,401 @@
+/*!*****************************************************************************
+*\file     small_deque.h
+*\author   Jalin A. Brown
+*\email    JalinBrownWorks@gmail.com
+
+*\brief Description:
+  Deque with inline storage for its first N elements.
+
+  A default-constructed Deque allocates on its first Push_back and again at
+  capacities 2, 4, 8, ... SmallDeque<T, N> keeps an N-slot buffer inside the
+  object, right next to the Deque header, and starts out with that buffer
+  as its array. It only goes to the heap once it holds more than N
+  elements, and comes back to the inline buffer when it shrinks to N again.
+
+  The Deque itself is unchanged. SmallDeque hands it an InlineAllocator:
+
+  1) allocate(n) returns the inline buffer when n fits and the buffer is not
+     in use, and heap memory otherwise. The buffer must be tracked as in use
+     because reallocate allocates the new array before freeing the old one.
+
+  2) deallocate() recognizes the inline buffer and just marks it free.
+
+  3) The shrink policy's min_capacity is never below N, set_shrink_policy
+     raises it, so pops and shrink_to_fit never shrink the array below the
+     inline buffer and lose it to a smaller heap block.
+
+  Because the buffer belongs to one object, SmallDeques are copied element
+  by element into their own buffers and do not offer swap(). A move takes
+  over a heap array as it is, but elements in the inline buffer are moved
+  across one by one.
+
+******************************************************************************/
+
+#ifndef WRAPBUFFER_SMALL_DEQUE_H
+#define WRAPBUFFER_SMALL_DEQUE_H
+
+//-----------------------------------------------------------------------------
+// Includes:
+//-----------------------------------------------------------------------------
+
+#include "deque.h"
+#include <cstddef>
+#include <memory>
+#include <ostream>
+#include <type_traits>
+#include <utility>
+
+//-----------------------------------------------------------------------------
+// Public Structures:
+//-----------------------------------------------------------------------------
+
+namespace WrapBuffer {
+
+  // Inline buffer owned by a SmallDeque, lent out by InlineAllocator
+  struct InlineArena
+  {
+    void* buffer;       // First inline slot
+    std::size_t slots;  // Number of inline slots
+    bool in_use;        // Whether the Deque's array is the inline buffer
+  };
+
+  // Allocator that serves one inline buffer first and the heap after that
+  template <typename T>
+  class InlineAllocator
+  {
+    template <typename U>
+    friend class InlineAllocator;
+
+  public:
+    using value_type = T;
+
+    // Propagation keeps an arena with the object that owns it.
+    using propagate_on_container_copy_assignment = std::false_type;
+    using propagate_on_container_move_assignment = std::false_type;
+    using propagate_on_container_swap            = std::false_type;
+    using is_always_equal                        = std::false_type;
+
+    // Heap-only allocator
+    InlineAllocator() : arena(nullptr) {}
+
+    // Allocator serving "arena_" first
+    explicit InlineAllocator(InlineArena* arena_) : arena(arena_) {}
+
+    // Rebound copies cannot share an arena sized for T, they use the heap
+    template <typename U>
+    InlineAllocator(const InlineAllocator<U>&) : arena(nullptr) {}
+
+    T* allocate(std::size_t n)
+    {
+      if (arena && !arena->in_use && n <= arena->slots)
+      {
+        arena->in_use = true;
+        return static_cast<T*>(arena->buffer);
+      }
+      return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T* p, std::size_t n)
+    {
+      if (arena && p == arena->buffer)
+      {
+        arena->in_use = false;
+        return;
+      }
+      std::allocator<T>().deallocate(p, n);
+    }
+
+    // A copy of a Deque gets its own storage, never this arena
+    InlineAllocator select_on_container_copy_construction() const { return InlineAllocator(); }
+
+    friend bool operator==(const InlineAllocator& l, const InlineAllocator& r) { return l.arena == r.arena; }
+    friend bool operator!=(const InlineAllocator& l, const InlineAllocator& r) { return l.arena != r.arena; }
+
+  private:
+    InlineArena* arena; // Inline buffer to serve first, or null
+  };
+
+  // Inline slots for a SmallDeque, constructed before its Deque base
+  template <typename T, std::size_t Slots>
+  struct InlineSlots
+  {
+    InlineSlots() : arena{ bytes, Slots, false } {}
+    InlineSlots(const InlineSlots&) = delete;
+    InlineSlots& operator=(const InlineSlots&) = delete;
+
+    alignas(T) unsigned char bytes[Slots * sizeof(T)];
+    InlineArena arena;
+  };
+
+  template <typename T, std::size_t N, typename Wrap = ModuloWrap>
+  class SmallDeque
+    : private InlineSlots<T, Wrap::round_capacity(N)>,
+      private Deque<T, InlineAllocator<T>, Wrap>
+  {
+    static_assert(N > 0, "SmallDeque needs at least one inline slot");
+
+    using slots_type = InlineSlots<T, Wrap::round_capacity(N)>;
+    using base_type  = Deque<T, InlineAllocator<T>, Wrap>;
+
+  public:
+    using typename base_type::value_type;
+    using typename base_type::size_type;
+    using typename base_type::difference_type;
+    using typename base_type::reference;
+    using typename base_type::const_reference;
+    using typename base_type::iterator;
+    using typename base_type::const_iterator;
+    using typename base_type::reverse_iterator;
+    using typename base_type::const_reverse_iterator;
+
+    // Number of elements held without touching the heap
+    static constexpr std::size_t inline_capacity = Wrap::round_capacity(N);
+
+    // Default CTOR
+    SmallDeque();
+
+    // Parameterized CTOR
+    SmallDeque(const T* array_, size_type size_);
+
+    // Copy CTOR
+    SmallDeque(const SmallDeque& rhs);
+
+    // Move CTOR
+    SmallDeque(SmallDeque&& rhs) noexcept(std::is_nothrow_move_constructible<T>::value);
+
+    // Assignment Operator
+    SmallDeque& operator=(const SmallDeque& rhs);
+
+    // Move Assignment Operator
+    SmallDeque& operator=(SmallDeque&& rhs) noexcept(std::is_nothrow_move_constructible<T>::value);
+
+    // Whether the elements currently live in the inline buffer
+    bool is_inline() const;
+
+    // Clear the SmallDeque, free any heap array and go back to the inline buffer
+    void Clear_and_release();
+
+    // Set the shrink policy, min_capacity is raised to inline_capacity
+    void set_shrink_policy(const ShrinkPolicy& policy);
+
+    using base_type::Size;
+    using base_type::Empty;
+    using base_type::Clear;
+    using base_type::Secure_clear;
+    using base_type::Capacity;
+    using base_type::Push_back;
+    using base_type::emplace_back;
+    using base_type::Pop_back;
+    using base_type::Push_front;
+    using base_type::emplace_front;
+    using base_type::Pop_front;
+    using base_type::operator[];
+    using base_type::push_back_n;
+    using base_type::push_front_n;
+    using base_type::pop_front_n;
+    using base_type::pop_back_n;
+    using base_type::reverse;
+    using base_type::normalize;
+    using base_type::reserve;
+    using base_type::shrink_policy;
+    using base_type::shrink_to_fit;
+    using base_type::begin;
+    using base_type::end;
+    using base_type::cbegin;
+    using base_type::cend;
+    using base_type::rbegin;
+    using base_type::rend;
+    using base_type::for_each_segment;
+    using base_type::for_each;
+
+    // Addition and assignment operator +=
+    SmallDeque& operator+=(const SmallDeque& rhs);
+
+  private:
+    // Take rhs's elements, this must be empty and on its inline buffer
+    void move_from(SmallDeque& rhs);
+  };
+
+  // Write the elements as text, "format" picks the separators (text_io.h)
+  template <typename T, std::size_t N, typename Wrap>
+  std::ostream& write_text(std::ostream& os, const SmallDeque<T, N, Wrap>& d, const TextFormat& format = TextFormat());
+
+  // Stream Operator Overload
+  template <typename T, std::size_t N, typename Wrap>
+  std::ostream& operator<<(std::ostream& os, const SmallDeque<T, N, Wrap>& d);
+
+  //-----------------------------------------------------------------------------
+  // Public Functions:
+  //-----------------------------------------------------------------------------
+
+  // Default CTOR
+  template <typename T, std::size_t N, typename Wrap>
+  SmallDeque<T, N, Wrap>::SmallDeque()
+    : slots_type(), base_type(ShrinkPolicy{ inline_capacity }, InlineAllocator<T>(&this->arena))
+  {
+    // Start out on the inline buffer instead of growing from capacity 1.
+    base_type::reserve(inline_capacity);
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Parameterized CTOR
+  template <typename T, std::size_t N, typename Wrap>
+  SmallDeque<T, N, Wrap>::SmallDeque(const T* array_, size_type size_) : SmallDeque()
+  {
+    base_type::push_back_n(array_, size_);
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Copy CTOR
+  template <typename T, std::size_t N, typename Wrap>
+  SmallDeque<T, N, Wrap>::SmallDeque(const SmallDeque& rhs) : SmallDeque()
+  {
+    base_type::set_shrink_policy(rhs.shrink_policy());
+    base_type::operator+=(rhs);
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Move CTOR
+  template <typename T, std::size_t N, typename Wrap>
+  SmallDeque<T, N, Wrap>::SmallDeque(SmallDeque&& rhs) noexcept(std::is_nothrow_move_constructible<T>::value) 
+    : SmallDeque()
+  {
+    move_from(rhs);
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Assignment Operator
+  template <typename T, std::size_t N, typename Wrap>
+  SmallDeque<T, N, Wrap>& SmallDeque<T, N, Wrap>::operator=(const SmallDeque& rhs)
+  {
+    if (this != &rhs)
+    {
+      Clear();
+      base_type::set_shrink_policy(rhs.shrink_policy());
+      base_type::operator+=(rhs);
+    }
+    return *this;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Move Assignment Operator
+  template <typename T, std::size_t N, typename Wrap>
+  SmallDeque<T, N, Wrap>& SmallDeque<T, N, Wrap>::operator=(SmallDeque&& rhs) noexcept(std::is_nothrow_move_constructible<T>::value)
+  {
+    if (this != &rhs)
+    {
+      Clear_and_release();
+      move_from(rhs);
+    }
+    return *this;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Whether the elements currently live in the inline buffer
+  template <typename T, std::size_t N, typename Wrap>
+  bool SmallDeque<T, N, Wrap>::is_inline() const
+  {
+    return this->arena.in_use;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Clear the SmallDeque, free any heap array and go back to the inline buffer
+  template <typename T, std::size_t N, typename Wrap>
+  void SmallDeque<T, N, Wrap>::Clear_and_release()
+  {
+    base_type::Clear_and_release();
+    base_type::reserve(inline_capacity);
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Set the shrink policy, min_capacity is raised to inline_capacity
+  template <typename T, std::size_t N, typename Wrap>
+  void SmallDeque<T, N, Wrap>::set_shrink_policy(const ShrinkPolicy& policy)
+  {
+    // A smaller floor would let the array shrink off the inline buffer.
+    ShrinkPolicy clamped = policy;
+    if (clamped.min_capacity < inline_capacity)
+    {
+      clamped.min_capacity = inline_capacity;
+    }
+    base_type::set_shrink_policy(clamped);
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Addition and assignment operator +=
+  template <typename T, std::size_t N, typename Wrap>
+  SmallDeque<T, N, Wrap>& SmallDeque<T, N, Wrap>::operator+=(const SmallDeque& rhs)
+  {
+    base_type::operator+=(rhs);
+    return *this;
+  }
+
+  //-------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// Private Functions:
+//-----------------------------------------------------------------------------
+
+  // Take rhs's elements, this must be empty and on its inline buffer
+  template <typename T, std::size_t N, typename Wrap>
+  void SmallDeque<T, N, Wrap>::move_from(SmallDeque& rhs)
+  {
+    if (rhs.is_inline())
+    {
+      // The inline buffer cannot change owners, and everything in it fits
+      // in ours, so the elements move across without allocating.
+      base_type::set_shrink_policy(rhs.shrink_policy());
+      rhs.for_each([this](T& value)
+      {
+        base_type::emplace_back(std::move(value));
+      });
+      rhs.Clear();
+    }
+    else
+    {
+      // A heap array can. The two allocators compare unequal, their arenas
+      // differ, so Deque::swap does not apply, but InlineAllocator takes
+      // everything other than its own buffer from std::allocator, so ours
+      // can free an array that rhs's allocated. Give up our inline buffer,
+      // take the array over, and put rhs back on its own inline buffer.
+      base_type::Clear_and_release();
+      base_type::take_storage(rhs);
+      rhs.base_type::reserve(inline_capacity);
+    }
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Write the elements as text
+  template <typename T, std::size_t N, typename Wrap>
+  std::ostream& write_text(std::ostream& os, const SmallDeque<T, N, Wrap>& d, const TextFormat& format)
+  {
+    return detail::write_elements(os, d, format);
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Stream Operator Overload
+  template <typename T, std::size_t N, typename Wrap>
+  std::ostream& operator<<(std::ostream& os, const SmallDeque<T, N, Wrap>& d)
+  {
+    // Prints the elements followed by spaces.
+    return write_text(os, d);
+  }
+
+  //-------------------------------------------------------------------------
+
+}
+
+#endif // WRAPBUFFER_SMALL_DEQUE_H
+
+//-----------------------------------------------------------------------------
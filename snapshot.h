@@ -0,0 +1,550 @@
+/*!*****************************************************************************
+*\file     snapshot.h
+*\author   Jalin A. Brown
+*\email    JalinBrownWorks@gmail.com
+
+*\brief Description:
+  Binary snapshot format behind Deque::save(), Deque::load() and
+  Deque::map_readonly(), for trivially copyable element types.
+
+  A snapshot is a 64-byte header followed by the elements:
+
+    magic         8 bytes, "WBDEQUE" and a zero
+    version       4 bytes, currently 1
+    element_size  4 bytes, sizeof(T)
+    count         8 bytes, number of elements
+    checksum      8 bytes, of the element bytes
+    flags         4 bytes, bit 0 set when the elements are stored back to
+                  front (the Deque was reversed when it was saved)
+    (zero padding up to 64 bytes)
+
+  All fields are in the byte order of the machine that wrote them. The
+  elements start 64 bytes into the file, so a mapping of the file can be
+  read in place for any T aligned to 64 bytes or less.
+
+  1) save() hands the header and the ring's one or two contiguous runs to
+     writev(), so nothing is staged in a temporary buffer.
+
+  2) load() reads the elements straight into the Deque's array and checks
+     the checksum.
+
+  3) map_readonly() maps the file and serves reads from the mapping, so
+     only the pages that are touched are ever read from disk. It checks the
+     header but not the checksum, since that would read the whole file;
+     call verify() to check it.
+
+  POSIX only. On other targets the snapshot functions are not declared.
+
+******************************************************************************/
+
+#ifndef WRAPBUFFER_SNAPSHOT_H
+#define WRAPBUFFER_SNAPSHOT_H
+
+//-----------------------------------------------------------------------------
+// Includes:
+//-----------------------------------------------------------------------------
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define WRAPBUFFER_SNAPSHOT 1
+#include <cerrno>
+#include <system_error>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+#ifdef WRAPBUFFER_SNAPSHOT
+
+//-----------------------------------------------------------------------------
+// Private Structures:
+//-----------------------------------------------------------------------------
+
+namespace WrapBuffer {
+  namespace detail {
+
+    // First 64 bytes of a snapshot file
+    struct SnapshotHeader
+    {
+      static constexpr std::uint32_t current_version = 1;
+      static constexpr std::uint32_t reversed_flag = 1;
+
+      char magic[8];              // "WBDEQUE"
+      std::uint32_t version;      // Format version
+      std::uint32_t element_size; // sizeof(T)
+      std::uint64_t count;        // Number of elements
+      std::uint64_t checksum;     // SnapshotChecksum of the element bytes
+      std::uint32_t flags;        // reversed_flag when stored back to front
+      std::uint8_t padding[28];   // Zero, keeps the elements 64-byte aligned
+    };
+
+    static_assert(sizeof(SnapshotHeader) == 64, "SnapshotHeader must be 64 bytes");
+
+    constexpr char snapshot_magic[8] = { 'W', 'B', 'D', 'E', 'Q', 'U', 'E', '\0' };
+
+    //-------------------------------------------------------------------------
+
+    // 64-bit checksum over a stream of bytes, fed in any number of pieces.
+    // Four independent multiply-rotate lanes over 32-byte blocks, so it runs
+    // at several bytes per cycle instead of waiting on one long chain.
+    class SnapshotChecksum
+    {
+    public:
+      // Add "bytes" bytes to the stream
+      void update(const void* data, std::size_t bytes)
+      {
+        const unsigned char* p = static_cast<const unsigned char*>(data);
+        total += bytes;
+
+        // Finish a block started by the previous piece.
+        if (pending)
+        {
+          std::size_t take = (bytes < 32 - pending) ? bytes : 32 - pending;
+          std::memcpy(block + pending, p, take);
+          pending += take;
+          p += take;
+          bytes -= take;
+          if (pending < 32)
+          {
+            return;
+          }
+          consume(block);
+          pending = 0;
+        }
+
+        for (; bytes >= 32; p += 32, bytes -= 32)
+        {
+          consume(p);
+        }
+
+        std::memcpy(block, p, bytes);
+        pending = bytes;
+      }
+
+      // Checksum of everything added so far
+      std::uint64_t digest() const
+      {
+        std::uint64_t h = rotl(lanes[0], 1) + rotl(lanes[1], 7) + rotl(lanes[2], 12) + rotl(lanes[3], 18);
+        h ^= total;
+        for (std::size_t i = 0; i < pending; ++i)
+        {
+          h = rotl(h ^ (block[i] * prime5), 11) * prime1;
+        }
+
+        // Final avalanche so every input bit reaches every output bit.
+        h ^= h >> 33;
+        h *= prime2;
+        h ^= h >> 29;
+        h *= prime3;
+        h ^= h >> 32;
+        return h;
+      }
+
+    private:
+      static constexpr std::uint64_t prime1 = 0x9E3779B185EBCA87ull;
+      static constexpr std::uint64_t prime2 = 0xC2B2AE3D27D4EB4Full;
+      static constexpr std::uint64_t prime3 = 0x165667B19E3779F9ull;
+      static constexpr std::uint64_t prime5 = 0x27D4EB2F165667C5ull;
+
+      static std::uint64_t rotl(std::uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+
+      static std::uint64_t round(std::uint64_t acc, std::uint64_t word)
+      {
+        return rotl(acc + word * prime2, 31) * prime1;
+      }
+
+      // Fold one 32-byte block into the lanes
+      void consume(const unsigned char* p)
+      {
+        std::uint64_t w[4];
+        std::memcpy(w, p, 32);
+        lanes[0] = round(lanes[0], w[0]);
+        lanes[1] = round(lanes[1], w[1]);
+        lanes[2] = round(lanes[2], w[2]);
+        lanes[3] = round(lanes[3], w[3]);
+      }
+
+      std::uint64_t lanes[4] = { prime1 + prime2, prime2, 0, 0 - prime1 }; // Running state
+      std::uint64_t total = 0;     // Bytes added so far
+      unsigned char block[32];     // Start of a block not yet consumed
+      std::size_t pending = 0;     // Bytes in "block"
+    };
+
+    //-------------------------------------------------------------------------
+
+    // Fill in a header for "count" elements of "element_size" bytes
+    inline SnapshotHeader make_snapshot_header(std::size_t element_size, std::size_t count, std::uint64_t checksum, bool reversed)
+    {
+      SnapshotHeader header;
+      std::memset(&header, 0, sizeof(header));
+      std::memcpy(header.magic, snapshot_magic, sizeof(header.magic));
+      header.version = SnapshotHeader::current_version;
+      header.element_size = static_cast<std::uint32_t>(element_size);
+      header.count = count;
+      header.checksum = checksum;
+      header.flags = reversed ? SnapshotHeader::reversed_flag : 0;
+      return header;
+    }
+
+    //-------------------------------------------------------------------------
+
+    // Throw unless "header" describes elements of "element_size" bytes
+    inline void check_snapshot_header(const SnapshotHeader& header, std::size_t element_size)
+    {
+      if (std::memcmp(header.magic, snapshot_magic, sizeof(header.magic)) != 0)
+      {
+        throw std::runtime_error("Not a Deque snapshot");
+      }
+      if (header.version != SnapshotHeader::current_version)
+      {
+        throw std::runtime_error("Unsupported snapshot version");
+      }
+      if (header.element_size != element_size)
+      {
+        throw std::runtime_error("Snapshot element size does not match");
+      }
+    }
+
+    //-------------------------------------------------------------------------
+
+    // writev() every byte of "iov", retrying short writes and EINTR
+    inline void write_all(int fd, struct iovec* iov, int count)
+    {
+      while (count > 0)
+      {
+        ssize_t written = ::writev(fd, iov, count);
+        if (written < 0)
+        {
+          if (errno == EINTR)
+          {
+            continue;
+          }
+          throw std::system_error(errno, std::system_category(), "writev");
+        }
+
+        // Skip the buffers that went out whole, then trim the next one.
+        std::size_t left = static_cast<std::size_t>(written);
+        while (count > 0 && left >= iov->iov_len)
+        {
+          left -= iov->iov_len;
+          ++iov;
+          --count;
+        }
+        if (count > 0)
+        {
+          iov->iov_base = static_cast<char*>(iov->iov_base) + left;
+          iov->iov_len -= left;
+        }
+      }
+    }
+
+    //-------------------------------------------------------------------------
+
+    // read() exactly "bytes" bytes, retrying short reads and EINTR
+    inline void read_all(int fd, void* dst, std::size_t bytes)
+    {
+      char* p = static_cast<char*>(dst);
+      while (bytes > 0)
+      {
+        ssize_t got = ::read(fd, p, bytes);
+        if (got < 0)
+        {
+          if (errno == EINTR)
+          {
+            continue;
+          }
+          throw std::system_error(errno, std::system_category(), "read");
+        }
+        if (got == 0)
+        {
+          throw std::runtime_error("Truncated snapshot");
+        }
+        p += got;
+        bytes -= static_cast<std::size_t>(got);
+      }
+    }
+
+  }
+
+  //-----------------------------------------------------------------------------
+  // Public Structures:
+  //-----------------------------------------------------------------------------
+
+  // Read-only view of a snapshot file, served from a private mapping
+  template <typename T>
+  class MappedDeque
+  {
+    static_assert(std::is_trivially_copyable<T>::value, "MappedDeque needs a trivially copyable T");
+
+  public:
+    using value_type = T;
+    using size_type  = std::size_t;
+
+    // Map the snapshot at "path", throws if it is not a snapshot of T
+    explicit MappedDeque(const char* path);
+
+    // Move CTOR
+    MappedDeque(MappedDeque&& rhs) noexcept;
+
+    // Move Assignment Operator
+    MappedDeque& operator=(MappedDeque&& rhs) noexcept;
+
+    MappedDeque(const MappedDeque&) = delete;
+    MappedDeque& operator=(const MappedDeque&) = delete;
+
+    // DTOR, unmaps the file
+    ~MappedDeque();
+
+    // Get the size of the snapshot
+    size_type Size() const;
+
+    // Check if the snapshot is empty
+    bool Empty() const;
+
+    // Index Operator
+    const T& operator[](size_type pos) const;
+
+    // Call f(const T* data, size_type count) for each contiguous run, front
+    // to back. A snapshot saved reversed hands out one-element runs.
+    template <typename F>
+    void for_each_segment(F f) const;
+
+    // Call f on every element, front to back
+    template <typename F>
+    void for_each(F f) const;
+
+    // Whether the elements match the header's checksum, reads every page
+    bool verify() const;
+
+  private:
+    // Unmap the file, if mapped
+    void unmap();
+
+    void* base;             // Start of the mapping
+    std::size_t length;     // Bytes mapped
+    const T* items;         // First stored element
+    size_type count;        // Number of elements
+    std::uint64_t checksum; // From the header
+    bool reversed;          // Whether the elements are stored back to front
+  };
+
+  //-----------------------------------------------------------------------------
+  // Public Functions:
+  //-----------------------------------------------------------------------------
+
+  // Map the snapshot at "path"
+  template <typename T>
+  MappedDeque<T>::MappedDeque(const char* path)
+    : base(nullptr), length(0), items(nullptr), count(0), checksum(0), reversed(false)
+  {
+    static_assert(alignof(T) <= sizeof(detail::SnapshotHeader), "T is aligned past the snapshot header");
+
+    int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+      throw std::system_error(errno, std::system_category(), "open");
+    }
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0)
+    {
+      int err = errno;
+      ::close(fd);
+      throw std::system_error(err, std::system_category(), "fstat");
+    }
+    if (static_cast<std::size_t>(st.st_size) < sizeof(detail::SnapshotHeader))
+    {
+      ::close(fd);
+      throw std::runtime_error("Truncated snapshot");
+    }
+
+    length = static_cast<std::size_t>(st.st_size);
+    base = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    int err = errno;
+    ::close(fd);
+    if (base == MAP_FAILED)
+    {
+      base = nullptr;
+      throw std::system_error(err, std::system_category(), "mmap");
+    }
+
+    // The mapping outlives the descriptor, so every exit from here unmaps.
+    try
+    {
+      detail::SnapshotHeader header;
+      std::memcpy(&header, base, sizeof(header));
+      detail::check_snapshot_header(header, sizeof(T));
+      if (header.count > (length - sizeof(header)) / sizeof(T))
+      {
+        throw std::runtime_error("Truncated snapshot");
+      }
+
+      items = reinterpret_cast<const T*>(static_cast<const char*>(base) + sizeof(header));
+      count = static_cast<size_type>(header.count);
+      checksum = header.checksum;
+      reversed = (header.flags & detail::SnapshotHeader::reversed_flag) != 0;
+    }
+    catch (...)
+    {
+      unmap();
+      throw;
+    }
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Move CTOR
+  template <typename T>
+  MappedDeque<T>::MappedDeque(MappedDeque&& rhs) noexcept
+    : base(rhs.base), length(rhs.length), items(rhs.items), count(rhs.count), checksum(rhs.checksum), reversed(rhs.reversed)
+  {
+    rhs.base = nullptr;
+    rhs.length = 0;
+    rhs.items = nullptr;
+    rhs.count = 0;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Move Assignment Operator
+  template <typename T>
+  MappedDeque<T>& MappedDeque<T>::operator=(MappedDeque&& rhs) noexcept
+  {
+    if (this != &rhs)
+    {
+      unmap();
+      base = rhs.base;
+      length = rhs.length;
+      items = rhs.items;
+      count = rhs.count;
+      checksum = rhs.checksum;
+      reversed = rhs.reversed;
+
+      rhs.base = nullptr;
+      rhs.length = 0;
+      rhs.items = nullptr;
+      rhs.count = 0;
+    }
+    return *this;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // DTOR
+  template <typename T>
+  MappedDeque<T>::~MappedDeque()
+  {
+    unmap();
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Get the size of the snapshot
+  template <typename T>
+  typename MappedDeque<T>::size_type MappedDeque<T>::Size() const
+  {
+    return count;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Check if the snapshot is empty
+  template <typename T>
+  bool MappedDeque<T>::Empty() const
+  {
+    return count == 0;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Index Operator
+  template <typename T>
+  const T& MappedDeque<T>::operator[](size_type pos) const
+  {
+    if (pos >= count)
+    {
+      throw std::out_of_range("Index out of range");
+    }
+    return items[reversed ? count - 1 - pos : pos];
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Call f(const T* data, size_type count) for each contiguous run
+  template <typename T>
+  template <typename F>
+  void MappedDeque<T>::for_each_segment(F f) const
+  {
+    if (!reversed)
+    {
+      if (count)
+      {
+        f(items, count);
+      }
+      return;
+    }
+
+    for (size_type i = count; i-- > 0;)
+    {
+      f(items + i, size_type(1));
+    }
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Call f on every element, front to back
+  template <typename T>
+  template <typename F>
+  void MappedDeque<T>::for_each(F f) const
+  {
+    for_each_segment([&f](const T* data, size_type n)
+    {
+      for (size_type i = 0; i < n; ++i)
+      {
+        f(data[i]);
+      }
+    });
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Whether the elements match the header's checksum
+  template <typename T>
+  bool MappedDeque<T>::verify() const
+  {
+    detail::SnapshotChecksum sum;
+    sum.update(items, count * sizeof(T));
+    return sum.digest() == checksum;
+  }
+
+  //-----------------------------------------------------------------------------
+  // Private Functions:
+  //-----------------------------------------------------------------------------
+
+  // Unmap the file, if mapped
+  template <typename T>
+  void MappedDeque<T>::unmap()
+  {
+    if (base)
+    {
+      ::munmap(base, length);
+      base = nullptr;
+    }
+  }
+
+  //-------------------------------------------------------------------------
+
+}
+
+#endif // WRAPBUFFER_SNAPSHOT
+
+#endif // WRAPBUFFER_SNAPSHOT_H
+
+//-----------------------------------------------------------------------------
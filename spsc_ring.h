@@ -0,0 +1,247 @@
+/*!*****************************************************************************
+*\file     spsc_ring.h
+*\author   Jalin A. Brown
+*\email    JalinBrownWorks@gmail.com
+
+*\brief Description:
+  Lock-free single-producer/single-consumer ring built on the Deque layout.
+
+  One thread calls Push_back, one other thread calls Pop_front. The ring
+  keeps the Deque's "b" (front) and "e" (back) indices and its wrap step,
+  with a fixed power-of-two capacity so the wrap is the PowerOfTwoWrap mask:
+
+    e = (e + 1) & (capacity - 1);
+
+  Here "b" and "e" are free-running counters and are only masked when a slot
+  is addressed, so size is simply e - b and a full ring needs no spare slot.
+
+  1) The producer owns "e" and the consumer owns "b". Each side publishes
+     its own index with a release store and reads the other with an acquire
+     load, which is what hands an element's construction from one thread to
+     the other.
+
+  2) Each side keeps a cached copy of the other side's index and only
+     reloads the shared atomic when the cache says the ring is full (or
+     empty). In the steady state neither side touches the other's cache
+     line.
+
+  3) The two indices live on separate cache lines so the threads do not
+     false-share.
+
+  Both operations finish in a bounded number of steps, so Push_back and
+  Pop_front are wait-free. They return false instead of blocking or growing.
+
+******************************************************************************/
+
+#ifndef WRAPBUFFER_SPSC_RING_H
+#define WRAPBUFFER_SPSC_RING_H
+
+//-----------------------------------------------------------------------------
+// Includes:
+//-----------------------------------------------------------------------------
+
+#include "wrap_policy.h"
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+//-----------------------------------------------------------------------------
+// Public Structures:
+//-----------------------------------------------------------------------------
+
+namespace WrapBuffer {
+
+  template <typename T, typename Allocator = std::allocator<T>>
+  class SpscRing
+  {
+  public:
+    using value_type     = T;
+    using allocator_type = Allocator;
+    using size_type      = std::size_t;
+
+    // Capacity CTOR, rounded up to a power of two
+    explicit SpscRing(size_type capacity_, const Allocator& alloc_ = Allocator());
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    // DTOR
+    ~SpscRing();
+
+    // Producer: add a value to the back, false if the ring is full
+    bool Push_back(const T& val);
+    bool Push_back(T&& val);
+
+    // Producer: construct a value in place at the back, false if full
+    template <typename... Args>
+    bool emplace_back(Args&&... args);
+
+    // Consumer: move the front value into out, false if the ring is empty
+    bool Pop_front(T& out);
+
+    // Number of elements, exact only when neither side is running
+    size_type Size() const;
+
+    // Check if the ring is empty, exact only when neither side is running
+    bool Empty() const;
+
+    // Get the fixed capacity of the ring
+    size_type Capacity() const;
+
+  private:
+    using alloc_traits = std::allocator_traits<Allocator>;
+
+    // Map a free-running counter onto a slot of the array
+    size_type wrap(size_type x) const { return PowerOfTwoWrap::index(x, capacity); }
+
+    // Read-only after construction, shared by both sides
+    size_type capacity;                 // Number of slots, a power of two
+    T* array;                           // Raw storage, only [b, e) is constructed
+    Allocator alloc;                    // Source of the storage
+
+    // Producer side
+    alignas(cache_line_size) std::atomic<size_type> e; // Next slot to fill
+    size_type cached_b;                                 // Producer's last view of "b"
+
+    // Consumer side
+    alignas(cache_line_size) std::atomic<size_type> b; // Next slot to drain
+    size_type cached_e;                                 // Consumer's last view of "e"
+  };
+
+  //-----------------------------------------------------------------------------
+  // Public Functions:
+  //-----------------------------------------------------------------------------
+
+  // Capacity CTOR, rounded up to a power of two
+  template <typename T, typename Allocator>
+  SpscRing<T, Allocator>::SpscRing(size_type capacity_, const Allocator& alloc_)
+    : capacity(PowerOfTwoWrap::round_capacity(capacity_ ? capacity_ : 1)),
+      array(nullptr), alloc(alloc_), e(0), cached_b(0), b(0), cached_e(0)
+  {
+    array = alloc_traits::allocate(alloc, capacity);
+  }
+
+  //-------------------------------------------------------------------------
+
+  // DTOR
+  template <typename T, typename Allocator>
+  SpscRing<T, Allocator>::~SpscRing()
+  {
+    size_type last = e.load(std::memory_order_relaxed);
+    for (size_type i = b.load(std::memory_order_relaxed); i != last; ++i)
+    {
+      alloc_traits::destroy(alloc, array + wrap(i));
+    }
+    alloc_traits::deallocate(alloc, array, capacity);
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Producer: add a value to the back, false if the ring is full
+  template <typename T, typename Allocator>
+  bool SpscRing<T, Allocator>::Push_back(const T& val)
+  {
+    return emplace_back(val);
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Producer: add a value to the back, false if the ring is full
+  template <typename T, typename Allocator>
+  bool SpscRing<T, Allocator>::Push_back(T&& val)
+  {
+    return emplace_back(std::move(val));
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Producer: construct a value in place at the back, false if full
+  template <typename T, typename Allocator>
+  template <typename... Args>
+  bool SpscRing<T, Allocator>::emplace_back(Args&&... args)
+  {
+    // Only the producer writes "e", so its own index needs no ordering.
+    size_type end = e.load(std::memory_order_relaxed);
+
+    // Looks full: refresh the cached front to see what the consumer freed.
+    if (end - cached_b == capacity)
+    {
+      cached_b = b.load(std::memory_order_acquire);
+      if (end - cached_b == capacity)
+      {
+        return false;
+      }
+    }
+
+    alloc_traits::construct(alloc, array + wrap(end), std::forward<Args>(args)...);
+
+    // Publish the element to the consumer.
+    e.store(end + 1, std::memory_order_release);
+    return true;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Consumer: move the front value into out, false if the ring is empty
+  template <typename T, typename Allocator>
+  bool SpscRing<T, Allocator>::Pop_front(T& out)
+  {
+    // Only the consumer writes "b", so its own index needs no ordering.
+    size_type begin = b.load(std::memory_order_relaxed);
+
+    // Looks empty: refresh the cached back to see what the producer added.
+    if (begin == cached_e)
+    {
+      cached_e = e.load(std::memory_order_acquire);
+      if (begin == cached_e)
+      {
+        return false;
+      }
+    }
+
+    T* slot = array + wrap(begin);
+    out = std::move(*slot);
+    alloc_traits::destroy(alloc, slot);
+
+    // Hand the slot back to the producer.
+    b.store(begin + 1, std::memory_order_release);
+    return true;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Number of elements, exact only when neither side is running
+  template <typename T, typename Allocator>
+  typename SpscRing<T, Allocator>::size_type SpscRing<T, Allocator>::Size() const
+  {
+    // Read "b" first so the difference can never go negative.
+    size_type begin = b.load(std::memory_order_acquire);
+    return e.load(std::memory_order_acquire) - begin;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Check if the ring is empty, exact only when neither side is running
+  template <typename T, typename Allocator>
+  bool SpscRing<T, Allocator>::Empty() const
+  {
+    return Size() == 0;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Get the fixed capacity of the ring
+  template <typename T, typename Allocator>
+  typename SpscRing<T, Allocator>::size_type SpscRing<T, Allocator>::Capacity() const
+  {
+    return capacity;
+  }
+
+  //-------------------------------------------------------------------------
+
+}
+
+#endif // WRAPBUFFER_SPSC_RING_H
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,42 @@
+/*!*****************************************************************************
+*\file     check.h
+*\author   Jalin A. Brown
+*\email    JalinBrownWorks@gmail.com
+
+*\brief Description:
+  Minimal check macro for the tests. Unlike assert, it stays on in
+  optimized builds. A failed check prints the condition and its location
+  and aborts, so the sanitizers also print a stack.
+
+******************************************************************************/
+
+#ifndef WRAPBUFFER_TESTS_CHECK_H
+#define WRAPBUFFER_TESTS_CHECK_H
+
+//-----------------------------------------------------------------------------
+// Includes:
+//-----------------------------------------------------------------------------
+
+#include <cstdio>
+#include <cstdlib>
+
+//-----------------------------------------------------------------------------
+// Public Functions:
+//-----------------------------------------------------------------------------
+
+namespace WrapBufferTest {
+
+  // Report a failed check and stop
+  [[noreturn]] inline void fail(const char* condition, const char* file, int line)
+  {
+    std::fprintf(stderr, "%s:%d: check failed: %s\n", file, line, condition);
+    std::abort();
+  }
+
+}
+
+#define WB_CHECK(condition) ((condition) ? (void)0 : ::WrapBufferTest::fail(#condition, __FILE__, __LINE__))
+
+#endif // WRAPBUFFER_TESTS_CHECK_H
+
+//-----------------------------------------------------------------------------
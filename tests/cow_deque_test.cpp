@@ -0,0 +1,79 @@
+/*!*****************************************************************************
+*\file     cow_deque_test.cpp
+*\author   Jalin A. Brown
+*\email    JalinBrownWorks@gmail.com
+
+*\brief Description:
+  Randomized test of CowDeque against a std::deque model (see model.h).
+  The fuzz copies a handle and then pushes to the copy, so a write to a
+  Deque that is still shared must leave the other handle as it was. A
+  moved handle must take the Deque over without sharing it.
+
+  Build and run from the repository root (tests/run_tests.sh does this):
+    g++ -std=c++17 -g -O1 -fsanitize=address,undefined -I. tests/cow_deque_test.cpp -o cow_deque_test
+    ./cow_deque_test
+
+******************************************************************************/
+
+//-----------------------------------------------------------------------------
+// Includes:
+//-----------------------------------------------------------------------------
+
+#include "model.h"
+#include "cow_deque.h"
+#include <cstdio>
+#include <string>
+#include <utility>
+
+//-----------------------------------------------------------------------------
+// Private Functions:
+//-----------------------------------------------------------------------------
+
+namespace {
+
+  using namespace WrapBuffer;
+
+  // A moved handle takes the Deque over unshared, so its next write is in place
+  void move_does_not_share()
+  {
+    CowDeque<std::string> source;
+    for (int i = 0; i < 1000; ++i)
+    {
+      source.Push_back(std::to_string(i) + "-heap-allocated-payload");
+    }
+    const std::string* first = &source[0];
+
+    CowDeque<std::string> moved(std::move(source));
+    WB_CHECK(!moved.is_shared());
+    moved.Push_back("in place");
+    WB_CHECK(&moved[0] == first);
+
+    CowDeque<std::string> assigned;
+    assigned = std::move(moved);
+    WB_CHECK(!assigned.is_shared());
+    assigned.Push_back("in place");
+    WB_CHECK(&assigned[0] == first && assigned.Size() == 1002);
+
+    // A moved-from handle can be assigned again.
+    moved = assigned;
+    WB_CHECK(moved.is_shared() && moved.Size() == 1002);
+    std::printf("%-24s ok\n", "CowDeque move");
+  }
+
+}
+
+//-----------------------------------------------------------------------------
+// Public Functions:
+//-----------------------------------------------------------------------------
+
+int main()
+{
+  using WrapBufferTest::fuzz;
+
+  const int steps = 20000;
+  fuzz<CowDeque<std::string>>("CowDeque", 4, steps);
+  move_does_not_share();
+  return 0;
+}
+
+//-----------------------------------------------------------------------------
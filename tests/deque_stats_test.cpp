@@ -0,0 +1,74 @@
+/*!*****************************************************************************
+*\file     deque_stats_test.cpp
+*\author   Jalin A. Brown
+*\email    JalinBrownWorks@gmail.com
+
+*\brief Description:
+  CountingStats: peak_capacity must cover every array the Deque ends up
+  with, including one adopted by assignment or move, and neither
+  assignment nor a pop on an empty Deque counts as a shrink.
+
+  Build and run from the repository root (tests/run_tests.sh does this):
+    g++ -std=c++17 -g -O1 -fsanitize=address,undefined -I. tests/deque_stats_test.cpp -o deque_stats_test
+    ./deque_stats_test
+
+******************************************************************************/
+
+//-----------------------------------------------------------------------------
+// Includes:
+//-----------------------------------------------------------------------------
+
+#include "check.h"
+#include "deque.h"
+#include "deque_stats.h"
+#include <cstdio>
+#include <memory>
+#include <utility>
+
+//-----------------------------------------------------------------------------
+// Private Functions:
+//-----------------------------------------------------------------------------
+
+namespace {
+
+  using namespace WrapBuffer;
+
+  // CountingStats must track the array it ends up with
+  void stats_follow_capacity()
+  {
+    using Counted = Deque<int, std::allocator<int>, ModuloWrap, CountingStats>;
+    Counted c;
+    for (int i = 0; i < 100; ++i)
+    {
+      c.Push_back(i);
+    }
+
+    Counted x;
+    x.Push_back(1);
+    x = c;
+    WB_CHECK(x.stats().peak_capacity >= x.Capacity());
+    WB_CHECK(x.stats().shrinks == 0);
+
+    Counted moved(std::move(x));
+    WB_CHECK(moved.stats().peak_capacity >= moved.Capacity());
+
+    Counted empty;
+    empty.Pop_front();
+    empty.Pop_back();
+    WB_CHECK(empty.stats().empty_pops == 2 && empty.stats().shrinks == 0);
+    std::printf("%-24s ok\n", "CountingStats");
+  }
+
+}
+
+//-----------------------------------------------------------------------------
+// Public Functions:
+//-----------------------------------------------------------------------------
+
+int main()
+{
+  stats_follow_capacity();
+  return 0;
+}
+
+//-----------------------------------------------------------------------------
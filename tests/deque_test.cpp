@@ -0,0 +1,121 @@
+/*!*****************************************************************************
+*\file     deque_test.cpp
+*\author   Jalin A. Brown
+*\email    JalinBrownWorks@gmail.com
+
+*\brief Description:
+  Randomized test of Deque, with both wrap policies, against a std::deque
+  model (see model.h), and bulk pops whose element assignment throws.
+
+  Build and run from the repository root (tests/run_tests.sh does this):
+    g++ -std=c++17 -g -O1 -fsanitize=address,undefined -I. tests/deque_test.cpp -o deque_test
+    ./deque_test
+
+******************************************************************************/
+
+//-----------------------------------------------------------------------------
+// Includes:
+//-----------------------------------------------------------------------------
+
+#include "model.h"
+#include "deque.h"
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+//-----------------------------------------------------------------------------
+// Private Functions:
+//-----------------------------------------------------------------------------
+
+namespace {
+
+  using namespace WrapBuffer;
+
+  int assignments_left = -1;
+
+  // Copy-only element whose assignment throws once the countdown hits zero
+  struct Flaky
+  {
+    std::string text;
+
+    Flaky() = default;
+    Flaky(int i) : text(std::to_string(i) + "-heap-allocated-payload") {}
+    Flaky(const Flaky&) = default;
+    Flaky& operator=(const Flaky& rhs)
+    {
+      if (assignments_left >= 0 && assignments_left-- == 0)
+      {
+        throw std::runtime_error("assign");
+      }
+      text = rhs.text;
+      return *this;
+    }
+  };
+
+  //-------------------------------------------------------------------------
+
+  // A throwing assignment in a bulk pop leaves every element in the Deque
+  void bulk_pop_throws()
+  {
+    for (int back = 0; back < 2; ++back)
+    {
+      // Eight slots with the elements wrapped past the end of the array
+      Deque<Flaky> d;
+      for (int i = 0; i < 8; ++i)
+      {
+        d.Push_back(i);
+      }
+      for (int i = 0; i < 5; ++i)
+      {
+        d.Pop_front();
+        d.Push_back(8 + i);
+      }
+
+      Flaky out[5];
+      assignments_left = 2;
+      bool threw = false;
+      try
+      {
+        if (back)
+        {
+          d.pop_back_n(out, 5);
+        }
+        else
+        {
+          d.pop_front_n(out, 5);
+        }
+      }
+      catch (const std::runtime_error&)
+      {
+        threw = true;
+      }
+      assignments_left = -1;
+
+      WB_CHECK(threw && d.Size() == 8);
+      for (int i = 0; i < 8; ++i)
+      {
+        WB_CHECK(d[i].text == Flaky(5 + i).text);
+      }
+      WB_CHECK(d.pop_front_n(out, 5) == 5 && out[4].text == Flaky(9).text);
+    }
+    std::printf("%-24s ok\n", "Deque bulk pop throws");
+  }
+
+}
+
+//-----------------------------------------------------------------------------
+// Public Functions:
+//-----------------------------------------------------------------------------
+
+int main()
+{
+  using WrapBufferTest::fuzz;
+
+  const int steps = 20000;
+  fuzz<Deque<std::string>>("Deque", 1, steps);
+  fuzz<Deque<std::string, std::allocator<std::string>, PowerOfTwoWrap>>("Deque<PowerOfTwoWrap>", 2, steps);
+  bulk_pop_throws();
+  return 0;
+}
+
+//-----------------------------------------------------------------------------
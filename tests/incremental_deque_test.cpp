@@ -0,0 +1,40 @@
+/*!*****************************************************************************
+*\file     incremental_deque_test.cpp
+*\author   Jalin A. Brown
+*\email    JalinBrownWorks@gmail.com
+
+*\brief Description:
+  Randomized test of IncrementalDeque against a std::deque model (see
+  model.h). After each growth the elements are split between the old and
+  new arrays for a while, so reads, pops and copies are checked in the
+  middle of a migration too.
+
+  Build and run from the repository root (tests/run_tests.sh does this):
+    g++ -std=c++17 -g -O1 -fsanitize=address,undefined -I. tests/incremental_deque_test.cpp -o incremental_deque_test
+    ./incremental_deque_test
+
+******************************************************************************/
+
+//-----------------------------------------------------------------------------
+// Includes:
+//-----------------------------------------------------------------------------
+
+#include "model.h"
+#include "incremental_deque.h"
+#include <string>
+
+//-----------------------------------------------------------------------------
+// Public Functions:
+//-----------------------------------------------------------------------------
+
+int main()
+{
+  using namespace WrapBuffer;
+  using WrapBufferTest::fuzz;
+
+  const int steps = 20000;
+  fuzz<IncrementalDeque<std::string>>("IncrementalDeque", 6, steps);
+  return 0;
+}
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,208 @@
+/*!*****************************************************************************
+*\file     mirrored_ring_test.cpp
+*\author   Jalin A. Brown
+*\email    JalinBrownWorks@gmail.com
+
+*\brief Description:
+  Randomized test of MirroredRing against a std::deque model.
+
+  Pushes and pops at both ends, push_back_n, consume_front, writes through
+  back_space() with commit_back(), reserve() and Clear() run in a seeded
+  stream. After every step data() must hold exactly the model's elements
+  as one contiguous run. The test also follows the ring's start slot "b"
+  through the mapping, so it checks that "b" stays inside the first
+  mapping, that an element past the end of the array reads the same
+  through both mappings, and that the live range really did wrap and
+  grow, from a wrapped range too, along the way.
+
+  Linux only (memfd_create).
+
+  Build and run from the repository root (tests/run_tests.sh does this):
+    g++ -std=c++17 -g -O1 -fsanitize=address,undefined -I. tests/mirrored_ring_test.cpp -o mirrored_ring_test
+    ./mirrored_ring_test
+
+******************************************************************************/
+
+//-----------------------------------------------------------------------------
+// Includes:
+//-----------------------------------------------------------------------------
+
+#include "check.h"
+#include "mirrored_ring.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <random>
+
+//-----------------------------------------------------------------------------
+// Private Functions:
+//-----------------------------------------------------------------------------
+
+namespace {
+
+  using namespace WrapBuffer;
+  using Ring = MirroredRing<std::uint64_t>;
+
+  // Longest run for the bulk operations, over half a page of elements
+  const std::size_t max_run = 300;
+
+  //-------------------------------------------------------------------------
+
+  // How often the fuzz reached the cases worth checking
+  struct Coverage
+  {
+    int wrapped_steps = 0;   // Steps that ended with the live range wrapped
+    int growths = 0;         // New mappings
+    int wrapped_growths = 0; // New mappings made from a wrapped range
+  };
+
+  //-------------------------------------------------------------------------
+
+  // Run "steps" random operations on a fresh MirroredRing and the model
+  void fuzz(unsigned seed, int steps, Coverage& seen)
+  {
+    std::mt19937_64 rng(seed);
+    Ring ring;
+    std::deque<std::uint64_t> model;
+
+    // Start of the current mapping, so b = data() - base
+    const std::uint64_t* base = nullptr;
+    std::size_t capacity = 0;
+    bool wrapped = false;
+
+    for (int step = 0; step < steps; ++step)
+    {
+      std::uint64_t run[max_run];
+      std::size_t count = rng() % max_run;
+      for (std::size_t i = 0; i < count; ++i)
+      {
+        run[i] = rng();
+      }
+      int op = static_cast<int>(rng() % 10);
+      bool cleared = false;
+
+      switch (op)
+      {
+      case 0:
+        ring.Push_back(run[0] = rng());
+        model.push_back(run[0]);
+        break;
+      case 1:
+        ring.Push_front(run[0] = rng());
+        model.push_front(run[0]);
+        break;
+      case 2:
+        if (!model.empty())
+        {
+          WB_CHECK(ring.Pop_back() == model.back());
+          model.pop_back();
+        }
+        break;
+      case 3:
+        if (!model.empty())
+        {
+          WB_CHECK(ring.Pop_front() == model.front());
+          model.pop_front();
+        }
+        break;
+      case 4: case 5:
+        ring.push_back_n(run, count);
+        model.insert(model.end(), run, run + count);
+        break;
+      case 6: case 7:
+      {
+        std::size_t dropped = std::min(count, model.size());
+        ring.consume_front(count);
+        model.erase(model.begin(), model.begin() + dropped);
+        break;
+      }
+      case 8:
+      {
+        // Write in place after the back, as read() into back_space() would.
+        std::size_t room = ring.Capacity() - ring.Size();
+        std::size_t written = room ? count % (room + 1) : 0;
+        std::copy(run, run + written, ring.back_space());
+        ring.commit_back(written);
+        model.insert(model.end(), run, run + written);
+        break;
+      }
+      default:
+        if (rng() % 16 == 0)
+        {
+          ring.Clear();
+          model.clear();
+          cleared = true;
+        }
+        else
+        {
+          ring.reserve(ring.Size() + count);
+        }
+        break;
+      }
+
+      // Keep the ring to a few pages, so it wraps often.
+      if (model.size() > 3000)
+      {
+        ring.consume_front(2000);
+        model.erase(model.begin(), model.begin() + 2000);
+      }
+
+      // A new mapping and Clear() start at b = 0, except under a Push_front
+      // that grew the ring.
+      if (ring.Capacity() != capacity)
+      {
+        capacity = ring.Capacity();
+        base = ring.data() - (op == 1 ? capacity - 1 : 0);
+        ++seen.growths;
+        seen.wrapped_growths += wrapped;
+      }
+      else if (cleared)
+      {
+        base = ring.data();
+      }
+
+      WB_CHECK(ring.Size() == model.size());
+      WB_CHECK(std::equal(model.begin(), model.end(), ring.data()));
+      wrapped = false;
+      if (capacity)
+      {
+        std::size_t b = static_cast<std::size_t>(ring.data() - base);
+        WB_CHECK(b < capacity);
+        wrapped = (b + ring.Size() > capacity);
+        if (wrapped)
+        {
+          // The element at the end of the live range, seen through both mappings
+          std::size_t last = b + ring.Size() - 1;
+          WB_CHECK(base[last] == base[last - capacity]);
+          ++seen.wrapped_steps;
+        }
+      }
+      if (!model.empty())
+      {
+        std::size_t i = rng() % model.size();
+        WB_CHECK(ring[i] == model[i]);
+      }
+    }
+  }
+
+}
+
+//-----------------------------------------------------------------------------
+// Public Functions:
+//-----------------------------------------------------------------------------
+
+int main()
+{
+  Coverage seen;
+  for (unsigned seed = 1; seed <= 16; ++seed)
+  {
+    fuzz(seed, 2000, seen);
+  }
+  WB_CHECK(seen.wrapped_steps > 16 * 2000 / 10);
+  WB_CHECK(seen.wrapped_growths >= 4);
+  std::printf("%-24s ok\n", "MirroredRing");
+  return 0;
+}
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,293 @@
+/*!*****************************************************************************
+*\file     model.h
+*\author   Jalin A. Brown
+*\email    JalinBrownWorks@gmail.com
+
+*\brief Description:
+  Model-based fuzz shared by the tests of the sequential containers.
+
+  fuzz<C> runs a seeded stream of pushes, pops, copies, moves and clears on
+  C and on a std::deque<std::string> model, and compares the two element by
+  element along the way. Containers that have them also get reverse(),
+  the bulk _n operations, operator+ chains (including one whose operands
+  are all the destination) and operator~ on temporaries. Strings make every element own heap memory, so a
+  leaked, doubly destroyed or lost element shows up under
+  AddressSanitizer.
+
+******************************************************************************/
+
+#ifndef WRAPBUFFER_TESTS_MODEL_H
+#define WRAPBUFFER_TESTS_MODEL_H
+
+//-----------------------------------------------------------------------------
+// Includes:
+//-----------------------------------------------------------------------------
+
+#include "check.h"
+#include <algorithm>
+#include <cstdio>
+#include <deque>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+//-----------------------------------------------------------------------------
+// Public Functions:
+//-----------------------------------------------------------------------------
+
+namespace WrapBufferTest {
+
+  using Model = std::deque<std::string>;
+
+  // Whether C has reverse()
+  template <typename C, typename = void>
+  struct has_reverse : std::false_type {};
+  template <typename C>
+  struct has_reverse<C, std::void_t<decltype(std::declval<C&>().reverse())>> : std::true_type {};
+
+  // Whether C has operator+ between two containers
+  template <typename C, typename = void>
+  struct has_concat : std::false_type {};
+  template <typename C>
+  struct has_concat<C, std::void_t<decltype(std::declval<const C&>() + std::declval<const C&>())>> : std::true_type {};
+
+  // Whether C has operator~
+  template <typename C, typename = void>
+  struct has_flip : std::false_type {};
+  template <typename C>
+  struct has_flip<C, std::void_t<decltype(~std::declval<const C&>())>> : std::true_type {};
+
+  // Whether C has the bulk _n operations
+  template <typename C, typename = void>
+  struct has_bulk : std::false_type {};
+  template <typename C>
+  struct has_bulk<C, std::void_t<decltype(std::declval<C&>().push_back_n(nullptr, 0))>> : std::true_type {};
+
+  //-------------------------------------------------------------------------
+
+  // Values long enough to live on the heap
+  inline std::string make_value(std::mt19937& rng)
+  {
+    return std::to_string(rng()) + "-heap-allocated-payload";
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Compare every element through operator[] and the iterators
+  template <typename C>
+  void same(const C& c, const Model& model)
+  {
+    WB_CHECK(c.Size() == model.size());
+    WB_CHECK(c.Empty() == model.empty());
+    for (std::size_t i = 0; i < model.size(); ++i)
+    {
+      WB_CHECK(c[i] == model[i]);
+    }
+    WB_CHECK(std::equal(c.begin(), c.end(), model.begin(), model.end()));
+
+    bool threw = false;
+    try
+    {
+      (void)c[model.size()];
+    }
+    catch (const std::out_of_range&)
+    {
+      threw = true;
+    }
+    WB_CHECK(threw);
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Run "steps" random operations on C and the model
+  template <typename C>
+  void fuzz(const char* name, unsigned seed, int steps)
+  {
+    std::mt19937 rng(seed);
+    C c;
+    Model model;
+
+    for (int step = 0; step < steps; ++step)
+    {
+      switch (rng() % 18)
+      {
+      case 0: case 1: case 2:
+      {
+        std::string v = make_value(rng);
+        c.Push_back(v);
+        model.push_back(v);
+        break;
+      }
+      case 3: case 4:
+      {
+        std::string v = make_value(rng);
+        model.push_front(v);
+        c.Push_front(std::move(v));
+        break;
+      }
+      case 5:
+      {
+        // An argument that aliases an element of the container
+        if (!model.empty())
+        {
+          std::size_t i = rng() % model.size();
+          c.emplace_back(c[i]);
+          model.push_back(model[i]);
+        }
+        break;
+      }
+      case 6: case 7:
+        if (!model.empty())
+        {
+          WB_CHECK(c.Pop_back() == model.back());
+          model.pop_back();
+        }
+        break;
+      case 8: case 9:
+        if (!model.empty())
+        {
+          WB_CHECK(c.Pop_front() == model.front());
+          model.pop_front();
+        }
+        break;
+      case 10:
+      {
+        C copy(c);
+        same(copy, model);
+        copy.Push_back("copy only");
+        same(c, model);
+        C moved(std::move(copy));
+        WB_CHECK(moved.Size() == model.size() + 1);
+        break;
+      }
+      case 11:
+      {
+        C other;
+        other.Push_back("replaced");
+        other = c;
+        same(other, model);
+        C target;
+        target = std::move(other);
+        same(target, model);
+        c = std::move(target);
+        break;
+      }
+      case 12:
+        if constexpr (has_reverse<C>::value)
+        {
+          c.reverse();
+          std::reverse(model.begin(), model.end());
+        }
+        break;
+      case 13:
+        if constexpr (has_bulk<C>::value)
+        {
+          std::string run[5];
+          std::size_t count = rng() % 5;
+          for (std::size_t i = 0; i < count; ++i)
+          {
+            run[i] = make_value(rng);
+          }
+          if (rng() % 2)
+          {
+            c.push_back_n(run, count);
+            model.insert(model.end(), run, run + count);
+          }
+          else
+          {
+            c.push_front_n(run, count);
+            model.insert(model.begin(), run, run + count);
+          }
+        }
+        break;
+      case 14:
+        if constexpr (has_bulk<C>::value)
+        {
+          std::string out[5];
+          std::size_t want = rng() % 5;
+          if (rng() % 2)
+          {
+            std::size_t got = c.pop_front_n(out, want);
+            WB_CHECK(got == std::min(want, model.size()));
+            for (std::size_t i = 0; i < got; ++i)
+            {
+              WB_CHECK(out[i] == model.front());
+              model.pop_front();
+            }
+          }
+          else
+          {
+            // The popped run comes out in front-to-back order.
+            std::size_t got = c.pop_back_n(out, want);
+            WB_CHECK(got == std::min(want, model.size()));
+            for (std::size_t i = got; i-- > 0;)
+            {
+              WB_CHECK(out[i] == model.back());
+              model.pop_back();
+            }
+          }
+        }
+        break;
+      case 15:
+        if constexpr (has_concat<C>::value)
+        {
+          C other;
+          other.Push_back(make_value(rng));
+          Model joined = model;
+          joined.push_back(other[0]);
+          joined.insert(joined.end(), model.begin(), model.end());
+
+          // A chain of three, then one that starts from a temporary
+          C sum = c + other + c;
+          same(sum, joined);
+          C appended = C(c) + other + c;
+          same(appended, joined);
+
+          // Every operand is the destination.
+          if (model.size() < 200)
+          {
+            c = c + c + c;
+            Model tripled = model;
+            tripled.insert(tripled.end(), model.begin(), model.end());
+            tripled.insert(tripled.end(), model.begin(), model.end());
+            model = tripled;
+          }
+        }
+        break;
+      case 16:
+        if constexpr (has_flip<C>::value)
+        {
+          Model reversed(model.rbegin(), model.rend());
+          C flipped = ~C(c);
+          same(flipped, reversed);
+          same(~flipped, model);
+          c = ~std::move(c);
+          model = reversed;
+        }
+        break;
+      default:
+        if (rng() % 8 == 0)
+        {
+          c.Clear();
+          model.clear();
+        }
+        break;
+      }
+
+      if (step % 61 == 0)
+      {
+        same(c, model);
+      }
+    }
+
+    same(c, model);
+    std::printf("%-24s ok\n", name);
+  }
+
+}
+
+#endif // WRAPBUFFER_TESTS_MODEL_H
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,213 @@
+/*!*****************************************************************************
+*\file     mpmc_ring_test.cpp
+*\author   Jalin A. Brown
+*\email    JalinBrownWorks@gmail.com
+
+*\brief Description:
+  Threaded stress test of MpmcRing, plus its behavior when element code
+  throws.
+
+  1) Several producers push (producer, sequence) pairs through a small
+     ring while several consumers pop. Every pair must be popped exactly
+     once, and each consumer must see any one producer's sequence numbers
+     in increasing order.
+
+  2) A copy that throws before the claim, and a move assignment that
+     throws inside try_pop, must leave the ring usable, with no slot stuck.
+
+  Build and run from the repository root (tests/run_tests.sh does this):
+    g++ -std=c++17 -g -O1 -pthread -fsanitize=thread -I. tests/mpmc_ring_test.cpp -o mpmc_ring_test
+    ./mpmc_ring_test
+
+******************************************************************************/
+
+//-----------------------------------------------------------------------------
+// Includes:
+//-----------------------------------------------------------------------------
+
+#include "check.h"
+#include "mpmc_ring.h"
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+//-----------------------------------------------------------------------------
+// Private Functions:
+//-----------------------------------------------------------------------------
+
+namespace {
+
+  const unsigned producers = 4;
+  const unsigned consumers = 4;
+  const std::uint32_t per_producer = 50000;
+
+  //-------------------------------------------------------------------------
+
+  // Every pushed pair is popped once, in per-producer order
+  void stress()
+  {
+    WrapBuffer::MpmcRing<std::uint64_t> ring(16);
+    std::unique_ptr<std::atomic<unsigned char>[]> seen(new std::atomic<unsigned char>[producers * per_producer]);
+    for (std::size_t i = 0; i < producers * per_producer; ++i)
+    {
+      seen[i].store(0, std::memory_order_relaxed);
+    }
+    std::atomic<std::uint64_t> popped{ 0 };
+
+    std::vector<std::thread> threads;
+    for (unsigned p = 0; p < producers; ++p)
+    {
+      threads.emplace_back([&ring, p]
+      {
+        for (std::uint32_t i = 0; i < per_producer; ++i)
+        {
+          std::uint64_t value = (std::uint64_t(p) << 32) | i;
+          while (!ring.try_push(value))
+          {
+            std::this_thread::yield();
+          }
+        }
+      });
+    }
+    for (unsigned c = 0; c < consumers; ++c)
+    {
+      threads.emplace_back([&ring, &seen, &popped]
+      {
+        std::vector<std::int64_t> last(producers, -1);
+        std::uint64_t value;
+        while (popped.load(std::memory_order_relaxed) < producers * per_producer)
+        {
+          if (!ring.try_pop(value))
+          {
+            std::this_thread::yield();
+            continue;
+          }
+          std::uint32_t p = std::uint32_t(value >> 32);
+          std::uint32_t i = std::uint32_t(value);
+          WB_CHECK(p < producers && i < per_producer);
+          WB_CHECK(std::int64_t(i) > last[p]);
+          last[p] = i;
+          WB_CHECK(seen[p * per_producer + i].exchange(1) == 0);
+          popped.fetch_add(1, std::memory_order_relaxed);
+        }
+      });
+    }
+    for (std::thread& t : threads)
+    {
+      t.join();
+    }
+
+    for (std::size_t i = 0; i < producers * per_producer; ++i)
+    {
+      WB_CHECK(seen[i].load() == 1);
+    }
+    WB_CHECK(ring.Empty());
+    std::printf("%-24s ok\n", "MpmcRing stress");
+  }
+
+  //-------------------------------------------------------------------------
+
+  bool throw_on_copy = false;
+  bool throw_on_assign = false;
+
+  // Element whose copy and move assignment can be made to throw
+  struct Fragile
+  {
+    std::string text;
+
+    Fragile() = default;
+    explicit Fragile(std::string text_) : text(std::move(text_)) {}
+    Fragile(const Fragile& rhs) : text(rhs.text)
+    {
+      if (throw_on_copy)
+      {
+        throw std::runtime_error("copy");
+      }
+    }
+    Fragile(Fragile&& rhs) noexcept : text(std::move(rhs.text)) {}
+    Fragile& operator=(Fragile&& rhs)
+    {
+      if (throw_on_assign)
+      {
+        throw std::runtime_error("assign");
+      }
+      text = std::move(rhs.text);
+      return *this;
+    }
+  };
+
+  //-------------------------------------------------------------------------
+
+  // A throwing copy or pop leaves no slot stuck
+  void throwing_elements()
+  {
+    WrapBuffer::MpmcRing<Fragile> ring(4);
+    Fragile first("first-heap-allocated-payload");
+
+    throw_on_copy = true;
+    bool threw = false;
+    try
+    {
+      ring.try_push(first);
+    }
+    catch (const std::runtime_error&)
+    {
+      threw = true;
+    }
+    throw_on_copy = false;
+    WB_CHECK(threw && ring.Empty());
+
+    WB_CHECK(ring.try_push(first));
+    WB_CHECK(ring.try_push(Fragile("second")));
+
+    Fragile out;
+    throw_on_assign = true;
+    threw = false;
+    try
+    {
+      ring.try_pop(out);
+    }
+    catch (const std::runtime_error&)
+    {
+      threw = true;
+    }
+    throw_on_assign = false;
+    WB_CHECK(threw);
+    WB_CHECK(ring.try_pop(out) && out.text == "second");
+    WB_CHECK(!ring.try_pop(out));
+
+    // Several laps, so every slot is reused after the throws.
+    for (int lap = 0; lap < 8; ++lap)
+    {
+      for (int i = 0; i < 4; ++i)
+      {
+        WB_CHECK(ring.try_push(Fragile(std::to_string(i))));
+      }
+      WB_CHECK(!ring.try_push(Fragile("full")));
+      for (int i = 0; i < 4; ++i)
+      {
+        WB_CHECK(ring.try_pop(out) && out.text == std::to_string(i));
+      }
+    }
+    std::printf("%-24s ok\n", "MpmcRing throws");
+  }
+
+}
+
+//-----------------------------------------------------------------------------
+// Public Functions:
+//-----------------------------------------------------------------------------
+
+int main()
+{
+  throwing_elements();
+  stress();
+  return 0;
+}
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,129 @@
+/*!*****************************************************************************
+*\file     ring_buffer_test.cpp
+*\author   Jalin A. Brown
+*\email    JalinBrownWorks@gmail.com
+
+*\brief Description:
+  Randomized test of RingBuffer against a std::deque model (see model.h)
+  that drops its front once it holds more than N elements.
+
+  Build and run from the repository root (tests/run_tests.sh does this):
+    g++ -std=c++17 -g -O1 -fsanitize=address,undefined -I. tests/ring_buffer_test.cpp -o ring_buffer_test
+    ./ring_buffer_test
+
+******************************************************************************/
+
+//-----------------------------------------------------------------------------
+// Includes:
+//-----------------------------------------------------------------------------
+
+#include "model.h"
+#include "ring_buffer.h"
+#include <cstddef>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <utility>
+
+//-----------------------------------------------------------------------------
+// Private Functions:
+//-----------------------------------------------------------------------------
+
+namespace {
+
+  using namespace WrapBuffer;
+  using namespace WrapBufferTest;
+
+  // RingBuffer against a model that keeps only the newest N
+  template <std::size_t N>
+  void fuzz_ring(unsigned seed, int steps)
+  {
+    std::mt19937 rng(seed);
+    RingBuffer<std::string, N> ring;
+    Model model;
+
+    auto push = [&model](const std::string& v)
+    {
+      model.push_back(v);
+      if (model.size() > N)
+      {
+        model.pop_front();
+      }
+    };
+
+    for (int step = 0; step < steps; ++step)
+    {
+      switch (rng() % 8)
+      {
+      case 0: case 1: case 2:
+      {
+        std::string v = make_value(rng);
+        ring.Push_back(v);
+        push(v);
+        break;
+      }
+      case 3:
+        // Pushing the oldest element into a full ring overwrites its own slot.
+        if (!model.empty())
+        {
+          std::string v = model.front();
+          ring.Push_back(ring[0]);
+          push(v);
+        }
+        break;
+      case 4:
+        if (!model.empty())
+        {
+          WB_CHECK(ring.Pop_back() == model.back());
+          model.pop_back();
+        }
+        break;
+      case 5:
+        if (!model.empty())
+        {
+          WB_CHECK(ring.Pop_front() == model.front());
+          model.pop_front();
+        }
+        break;
+      case 6:
+      {
+        RingBuffer<std::string, N> copy(ring);
+        same(copy, model);
+        ring = std::move(copy);
+        break;
+      }
+      default:
+        if (rng() % 16 == 0)
+        {
+          ring.Clear();
+          model.clear();
+        }
+        break;
+      }
+
+      WB_CHECK(ring.Full() == (model.size() == N));
+      if (step % 61 == 0)
+      {
+        same(ring, model);
+      }
+    }
+
+    same(ring, model);
+    std::printf("RingBuffer<%-3zu>          ok\n", N);
+  }
+
+}
+
+//-----------------------------------------------------------------------------
+// Public Functions:
+//-----------------------------------------------------------------------------
+
+int main()
+{
+  const int steps = 20000;
+  fuzz_ring<1>(7, steps);
+  fuzz_ring<8>(8, steps);
+  return 0;
+}
+
+//-----------------------------------------------------------------------------
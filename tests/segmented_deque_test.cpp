@@ -0,0 +1,39 @@
+/*!*****************************************************************************
+*\file     segmented_deque_test.cpp
+*\author   Jalin A. Brown
+*\email    JalinBrownWorks@gmail.com
+
+*\brief Description:
+  Randomized test of SegmentedDeque against a std::deque model (see
+  model.h). Sixteen-element blocks make the fuzz add and free blocks at
+  both ends and grow the block map.
+
+  Build and run from the repository root (tests/run_tests.sh does this):
+    g++ -std=c++17 -g -O1 -fsanitize=address,undefined -I. tests/segmented_deque_test.cpp -o segmented_deque_test
+    ./segmented_deque_test
+
+******************************************************************************/
+
+//-----------------------------------------------------------------------------
+// Includes:
+//-----------------------------------------------------------------------------
+
+#include "model.h"
+#include "segmented_deque.h"
+#include <string>
+
+//-----------------------------------------------------------------------------
+// Public Functions:
+//-----------------------------------------------------------------------------
+
+int main()
+{
+  using namespace WrapBuffer;
+  using WrapBufferTest::fuzz;
+
+  const int steps = 20000;
+  fuzz<SegmentedDeque<std::string, 16>>("SegmentedDeque", 5, steps);
+  return 0;
+}
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,189 @@
+/*!*****************************************************************************
+*\file     simd_reverse_test.cpp
+*\author   Jalin A. Brown
+*\email    JalinBrownWorks@gmail.com
+
+*\brief Description:
+  Randomized test of the reverse kernels in simd_reverse.h.
+
+  1) Deque<short/int/long long>, with both wrap policies, is set up as a
+     wrapped ring of random size, capacity and start slot. reverse() plus
+     normalize(), and operator~, must match std::reverse of the elements.
+
+  2) The SSE2 and AVX2 entry points (AVX2 when the CPU has it) and the
+     scalar kernel are also called directly on raw rings, so each
+     instruction set is checked whichever one the Deque picks here.
+
+  Build and run from the repository root (tests/run_tests.sh does this):
+    g++ -std=c++17 -g -O1 -fsanitize=address,undefined -I. tests/simd_reverse_test.cpp -o simd_reverse_test
+    ./simd_reverse_test
+
+******************************************************************************/
+
+//-----------------------------------------------------------------------------
+// Includes:
+//-----------------------------------------------------------------------------
+
+#include "check.h"
+#include "deque.h"
+#include "simd_reverse.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <vector>
+
+//-----------------------------------------------------------------------------
+// Private Functions:
+//-----------------------------------------------------------------------------
+
+namespace {
+
+  using namespace WrapBuffer;
+
+  // Up to a few AVX2 blocks past the wrap point
+  const std::size_t max_size = 200;
+
+  //-------------------------------------------------------------------------
+
+  // Wrapped Deques of random shape against std::reverse
+  template <typename T, typename Wrap>
+  void fuzz_deque(const char* name, unsigned seed, int rounds)
+  {
+    using D = Deque<T, std::allocator<T>, Wrap>;
+    std::mt19937 rng(seed);
+
+    for (int round = 0; round < rounds; ++round)
+    {
+      std::size_t size = rng() % (max_size + 1);
+      D d;
+      d.set_shrink_policy(ShrinkPolicy{ 0, 4, false });
+      d.reserve(size + rng() % 70);
+
+      // Start the elements at a random slot, so most of them wrap.
+      std::size_t capacity = d.Capacity();
+      std::size_t offset = rng() % (capacity + 1);
+      for (std::size_t i = 0; i < offset; ++i)
+      {
+        d.Push_back(T());
+      }
+      for (std::size_t i = 0; i < offset; ++i)
+      {
+        d.Pop_front();
+      }
+
+      std::vector<T> model;
+      for (std::size_t i = 0; i < size; ++i)
+      {
+        T value = static_cast<T>(rng());
+        d.Push_back(value);
+        model.push_back(value);
+      }
+      WB_CHECK(d.Capacity() == capacity);
+      std::reverse(model.begin(), model.end());
+
+      // operator~ of the unreversed ring, then of the lazily reversed one
+      D flipped = ~d;
+      d.reverse();
+      D copied = ~d;
+      d.normalize();
+
+      WB_CHECK(d.Size() == size && flipped.Size() == size && copied.Size() == size);
+      for (std::size_t i = 0; i < size; ++i)
+      {
+        WB_CHECK(d[i] == model[i]);
+        WB_CHECK(flipped[i] == model[i]);
+        WB_CHECK(copied[i] == model[size - 1 - i]);
+      }
+    }
+    std::printf("%-24s ok\n", name);
+  }
+
+  //-------------------------------------------------------------------------
+
+  // One kernel on raw rings of random shape against std::reverse
+  template <typename T>
+  void fuzz_kernel(const char* name, void (*reverse)(T*, std::size_t, std::size_t, std::size_t),
+                   void (*reverse_copy)(const T*, std::size_t, std::size_t, std::size_t, T*), unsigned seed)
+  {
+    std::mt19937 rng(seed);
+
+    for (int round = 0; round < 2000; ++round)
+    {
+      std::size_t size = rng() % (max_size + 1);
+      std::size_t capacity = size + rng() % 70;
+      std::size_t b = capacity ? rng() % capacity : 0;
+
+      std::vector<T> ring(capacity);
+      for (T& value : ring)
+      {
+        value = static_cast<T>(rng());
+      }
+      std::vector<T> logical(size);
+      for (std::size_t i = 0; i < size; ++i)
+      {
+        logical[i] = ring[detail::ring_slot(b, i, capacity)];
+      }
+      std::vector<T> expected(logical.rbegin(), logical.rend());
+
+      // The copy must leave the ring alone and write exactly "size" slots.
+      std::vector<T> dst(size + 1, T(7));
+      reverse_copy(ring.data(), capacity, b, size, dst.data());
+      WB_CHECK(std::equal(expected.begin(), expected.end(), dst.begin()) && dst[size] == T(7));
+
+      std::vector<T> before = ring;
+      reverse(ring.data(), capacity, b, size);
+      for (std::size_t i = 0; i < capacity; ++i)
+      {
+        // Slots outside the elements must not be touched.
+        std::size_t pos = (i + capacity - b) % capacity;
+        WB_CHECK(ring[i] == (pos < size ? expected[pos] : before[i]));
+      }
+    }
+    std::printf("%-24s ok\n", name);
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Every kernel this build and CPU can run, for one element size
+  template <typename T>
+  void fuzz_kernels(const char* scalar, const char* sse2, const char* avx2, unsigned seed)
+  {
+    fuzz_kernel<T>(scalar, &detail::reverse_ring_with<detail::ScalarKernel, T>,
+                   &detail::reverse_copy_ring_with<detail::ScalarKernel, T>, seed);
+#ifdef WRAPBUFFER_X86_SIMD
+    fuzz_kernel<T>(sse2, &detail::reverse_ring_sse2<T>, &detail::reverse_copy_ring_sse2<T>, seed + 1);
+    if (detail::cpu_has_avx2())
+    {
+      fuzz_kernel<T>(avx2, &detail::reverse_ring_avx2<T>, &detail::reverse_copy_ring_avx2<T>, seed + 2);
+    }
+#else
+    (void)sse2;
+    (void)avx2;
+#endif
+  }
+
+}
+
+//-----------------------------------------------------------------------------
+// Public Functions:
+//-----------------------------------------------------------------------------
+
+int main()
+{
+  const int rounds = 3000;
+  fuzz_deque<short, ModuloWrap>("Deque<short>", 1, rounds);
+  fuzz_deque<int, ModuloWrap>("Deque<int>", 2, rounds);
+  fuzz_deque<long long, ModuloWrap>("Deque<long long>", 3, rounds);
+  fuzz_deque<short, PowerOfTwoWrap>("Deque<short, Pow2>", 4, rounds);
+  fuzz_deque<int, PowerOfTwoWrap>("Deque<int, Pow2>", 5, rounds);
+  fuzz_deque<long long, PowerOfTwoWrap>("Deque<long long, Pow2>", 6, rounds);
+
+  fuzz_kernels<short>("scalar<short>", "sse2<short>", "avx2<short>", 10);
+  fuzz_kernels<int>("scalar<int>", "sse2<int>", "avx2<int>", 20);
+  fuzz_kernels<long long>("scalar<long long>", "sse2<long long>", "avx2<long long>", 30);
+  return 0;
+}
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,133 @@
+/*!*****************************************************************************
+*\file     sliding_window_extrema_test.cpp
+*\author   Jalin A. Brown
+*\email    JalinBrownWorks@gmail.com
+
+*\brief Description:
+  Randomized test of SlidingWindowExtrema against a brute-force min/max
+  over a std::deque holding the window.
+
+  Pushes, random expire_older_than(n) calls and the occasional Clear() run
+  in a seeded stream, and min(), max(), Size() and Empty() are compared to
+  a full scan of the model after every step. Samples come from a small
+  range so ties are common. It runs on int with std::less and on
+  std::string with std::greater, where min() is the largest string.
+
+  Build and run from the repository root (tests/run_tests.sh does this):
+    g++ -std=c++17 -g -O1 -fsanitize=address,undefined -I. tests/sliding_window_extrema_test.cpp -o sliding_window_extrema_test
+    ./sliding_window_extrema_test
+
+******************************************************************************/
+
+//-----------------------------------------------------------------------------
+// Includes:
+//-----------------------------------------------------------------------------
+
+#include "check.h"
+#include "sliding_window_extrema.h"
+#include <algorithm>
+#include <cstdio>
+#include <deque>
+#include <functional>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+//-----------------------------------------------------------------------------
+// Private Functions:
+//-----------------------------------------------------------------------------
+
+namespace {
+
+  using namespace WrapBuffer;
+
+  // A sample from a range small enough to repeat often
+  template <typename T>
+  T make_sample(std::mt19937& rng);
+
+  template <>
+  int make_sample<int>(std::mt19937& rng)
+  {
+    return static_cast<int>(rng() % 50) - 25;
+  }
+
+  template <>
+  std::string make_sample<std::string>(std::mt19937& rng)
+  {
+    return std::to_string(rng() % 50) + "-heap-allocated-payload";
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Run "steps" random operations on the window and the model
+  template <typename T, typename Compare>
+  void fuzz(const char* name, unsigned seed, int steps)
+  {
+    std::mt19937 rng(seed);
+    SlidingWindowExtrema<T, Compare> window;
+    std::deque<T> model;
+    Compare comp;
+
+    for (int step = 0; step < steps; ++step)
+    {
+      unsigned op = rng() % 16;
+      if (op < 10)
+      {
+        T sample = make_sample<T>(rng);
+        window.push(sample);
+        model.push_back(sample);
+      }
+      else if (op < 15)
+      {
+        // Mostly a window near its current length, sometimes much shorter
+        std::size_t n = (op == 14 && rng() % 16 == 0) ? rng() % 4 : model.size() + 2 - rng() % 8;
+        window.expire_older_than(n);
+        while (model.size() > n)
+        {
+          model.pop_front();
+        }
+      }
+      else if (rng() % 8 == 0)
+      {
+        window.Clear();
+        model.clear();
+      }
+
+      WB_CHECK(window.Size() == model.size());
+      WB_CHECK(window.Empty() == model.empty());
+      if (model.empty())
+      {
+        bool threw = false;
+        try
+        {
+          window.min();
+        }
+        catch (const std::out_of_range&)
+        {
+          threw = true;
+        }
+        WB_CHECK(threw);
+      }
+      else
+      {
+        WB_CHECK(window.min() == *std::min_element(model.begin(), model.end(), comp));
+        WB_CHECK(window.max() == *std::max_element(model.begin(), model.end(), comp));
+      }
+    }
+    std::printf("%-24s ok\n", name);
+  }
+
+}
+
+//-----------------------------------------------------------------------------
+// Public Functions:
+//-----------------------------------------------------------------------------
+
+int main()
+{
+  fuzz<int, std::less<int>>("SlidingWindowExtrema<int>", 1, 50000);
+  fuzz<std::string, std::greater<std::string>>("SlidingWindowExtrema<str>", 2, 20000);
+  return 0;
+}
+
+//-----------------------------------------------------------------------------
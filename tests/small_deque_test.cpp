@@ -0,0 +1,105 @@
+/*!*****************************************************************************
+*\file     small_deque_test.cpp
+*\author   Jalin A. Brown
+*\email    JalinBrownWorks@gmail.com
+
+*\brief Description:
+  Randomized test of SmallDeque against a std::deque model (see model.h).
+  Eight inline slots make the fuzz cross between the inline buffer and the
+  heap in both directions. A shrink floor below N must not take the
+  elements off the inline buffer, and a move hands a heap array over.
+
+  Build and run from the repository root (tests/run_tests.sh does this):
+    g++ -std=c++17 -g -O1 -fsanitize=address,undefined -I. tests/small_deque_test.cpp -o small_deque_test
+    ./small_deque_test
+
+******************************************************************************/
+
+//-----------------------------------------------------------------------------
+// Includes:
+//-----------------------------------------------------------------------------
+
+#include "model.h"
+#include "small_deque.h"
+#include <cstdio>
+#include <string>
+#include <utility>
+
+//-----------------------------------------------------------------------------
+// Private Functions:
+//-----------------------------------------------------------------------------
+
+namespace {
+
+  using namespace WrapBuffer;
+  using Small = SmallDeque<std::string, 8>;
+
+  // A shrink floor below N cannot push the elements off the inline buffer
+  void floor_keeps_inline()
+  {
+    Small d;
+    d.set_shrink_policy(ShrinkPolicy{ 1 });
+    WB_CHECK(d.shrink_policy().min_capacity == Small::inline_capacity);
+
+    for (int i = 0; i < 100; ++i)
+    {
+      d.Push_back(std::to_string(i));
+    }
+    WB_CHECK(!d.is_inline());
+    while (d.Size() > 1)
+    {
+      d.Pop_front();
+    }
+    WB_CHECK(d.is_inline() && d[0] == "99");
+    d.shrink_to_fit();
+    WB_CHECK(d.is_inline() && d.Capacity() == Small::inline_capacity);
+    std::printf("%-24s ok\n", "SmallDeque shrink floor");
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Moving a heap SmallDeque hands the array over and puts rhs back inline
+  void move_heap_array()
+  {
+    Small source;
+    for (int i = 0; i < 20; ++i)
+    {
+      source.Push_back(std::to_string(i) + "-heap-allocated-payload");
+    }
+    const std::string* first = &source[0];
+
+    Small moved(std::move(source));
+    WB_CHECK(!moved.is_inline() && &moved[0] == first && moved.Size() == 20);
+    WB_CHECK(source.is_inline() && source.Empty());
+
+    Small assigned;
+    assigned.Push_back("replaced");
+    assigned = std::move(moved);
+    WB_CHECK(!assigned.is_inline() && &assigned[0] == first);
+    WB_CHECK(moved.is_inline() && moved.Empty());
+
+    // Both sides stay usable, and the heap array is freed by its new owner.
+    source.Push_back("again");
+    moved = std::move(source);
+    WB_CHECK(moved.is_inline() && moved.Size() == 1 && moved[0] == "again");
+    std::printf("%-24s ok\n", "SmallDeque move");
+  }
+
+}
+
+//-----------------------------------------------------------------------------
+// Public Functions:
+//-----------------------------------------------------------------------------
+
+int main()
+{
+  using WrapBufferTest::fuzz;
+
+  const int steps = 20000;
+  fuzz<SmallDeque<std::string, 8>>("SmallDeque", 3, steps);
+  floor_keeps_inline();
+  move_heap_array();
+  return 0;
+}
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,193 @@
+/*!*****************************************************************************
+*\file     snapshot_test.cpp
+*\author   Jalin A. Brown
+*\email    JalinBrownWorks@gmail.com
+
+*\brief Description:
+  Binary snapshots (snapshot.h): save() of a wrapped, lazily reversed Deque
+  and of an empty one must come back unchanged through load() and
+  map_readonly(). A snapshot with a flipped element byte must fail load()
+  and verify(), and one of another element size must fail both.
+
+  POSIX only. Writes a temporary file under /tmp and removes it.
+
+  Build and run from the repository root (tests/run_tests.sh does this):
+    g++ -std=c++17 -g -O1 -fsanitize=address,undefined -I. tests/snapshot_test.cpp -o snapshot_test
+    ./snapshot_test
+
+******************************************************************************/
+
+//-----------------------------------------------------------------------------
+// Includes:
+//-----------------------------------------------------------------------------
+
+#include "check.h"
+#include "deque.h"
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+#include <unistd.h>
+
+//-----------------------------------------------------------------------------
+// Private Functions:
+//-----------------------------------------------------------------------------
+
+namespace {
+
+  using namespace WrapBuffer;
+
+  char path[] = "/tmp/wrapbuffer_snapshot_XXXXXX";
+  int fd = -1;
+
+  //-------------------------------------------------------------------------
+
+  // Replace the file's contents with a snapshot of d
+  template <typename D>
+  void save(const D& d)
+  {
+    WB_CHECK(ftruncate(fd, 0) == 0 && lseek(fd, 0, SEEK_SET) == 0);
+    d.save(fd);
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Load the file into d, false if load() throws
+  template <typename D>
+  bool load(D& d)
+  {
+    WB_CHECK(lseek(fd, 0, SEEK_SET) == 0);
+    try
+    {
+      d.load(fd);
+    }
+    catch (const std::runtime_error&)
+    {
+      return false;
+    }
+    return true;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // d, the Deque it was loaded into and the mapping all hold the same elements
+  void same(const Deque<int>& d, const Deque<int>& loaded, const MappedDeque<int>& mapped)
+  {
+    WB_CHECK(loaded.Size() == d.Size() && mapped.Size() == d.Size());
+    WB_CHECK(mapped.Empty() == d.Empty());
+    for (std::size_t i = 0; i < d.Size(); ++i)
+    {
+      WB_CHECK(loaded[i] == d[i] && mapped[i] == d[i]);
+    }
+    std::size_t i = 0;
+    mapped.for_each([&d, &i](int value)
+    {
+      WB_CHECK(value == d[i++]);
+    });
+    WB_CHECK(i == d.Size() && mapped.verify());
+  }
+
+  //-------------------------------------------------------------------------
+
+  // A ring that wraps past the end of its array and is lazily reversed
+  void wrapped_reversed()
+  {
+    Deque<int> d;
+    d.set_shrink_policy(ShrinkPolicy{ 0, 4, false });
+    d.reserve(64);
+    for (int i = 0; i < 50; ++i)
+    {
+      d.Push_back(-1);
+      d.Pop_front();
+    }
+    for (int i = 0; i < 40; ++i)
+    {
+      d.Push_back(i * 7919);
+    }
+    d.reverse();
+    WB_CHECK(d.Capacity() == 64 && d[0] == 39 * 7919);
+
+    save(d);
+    Deque<int> loaded;
+    loaded.Push_back(12345);
+    WB_CHECK(load(loaded));
+    MappedDeque<int> mapped = Deque<int>::map_readonly(path);
+    same(d, loaded, mapped);
+
+    // The loaded Deque keeps working from the orientation it was saved in.
+    loaded.Push_front(-5);
+    WB_CHECK(loaded[0] == -5 && loaded[1] == 39 * 7919 && loaded.Size() == 41);
+    std::printf("%-24s ok\n", "snapshot wrapped");
+  }
+
+  //-------------------------------------------------------------------------
+
+  // An empty Deque round-trips to an empty one
+  void empty()
+  {
+    Deque<int> d;
+    save(d);
+    Deque<int> loaded;
+    loaded.Push_back(1);
+    WB_CHECK(load(loaded));
+    MappedDeque<int> mapped = Deque<int>::map_readonly(path);
+    same(d, loaded, mapped);
+    std::printf("%-24s ok\n", "snapshot empty");
+  }
+
+  //-------------------------------------------------------------------------
+
+  // A damaged snapshot and one of another type are rejected
+  void rejected()
+  {
+    int values[] = { 1, 2, 3, 4, 5 };
+    Deque<int> d(values, 5);
+    save(d);
+
+    // Flip one bit of the third element.
+    unsigned char byte;
+    WB_CHECK(pread(fd, &byte, 1, 64 + 2 * sizeof(int)) == 1);
+    byte ^= 0x10;
+    WB_CHECK(pwrite(fd, &byte, 1, 64 + 2 * sizeof(int)) == 1);
+
+    Deque<int> loaded;
+    loaded.Push_back(9);
+    WB_CHECK(!load(loaded) && loaded.Empty());
+    MappedDeque<int> mapped = Deque<int>::map_readonly(path);
+    WB_CHECK(mapped.Size() == 5 && !mapped.verify());
+
+    // Four-byte elements read as eight-byte ones
+    save(d);
+    Deque<long long> wide;
+    WB_CHECK(!load(wide) && wide.Empty());
+    bool threw = false;
+    try
+    {
+      Deque<long long>::map_readonly(path);
+    }
+    catch (const std::runtime_error&)
+    {
+      threw = true;
+    }
+    WB_CHECK(threw);
+    std::printf("%-24s ok\n", "snapshot rejected");
+  }
+
+}
+
+//-----------------------------------------------------------------------------
+// Public Functions:
+//-----------------------------------------------------------------------------
+
+int main()
+{
+  fd = mkstemp(path);
+  WB_CHECK(fd >= 0);
+  wrapped_reversed();
+  empty();
+  rejected();
+  close(fd);
+  unlink(path);
+  return 0;
+}
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,92 @@
+/*!*****************************************************************************
+*\file     spsc_ring_test.cpp
+*\author   Jalin A. Brown
+*\email    JalinBrownWorks@gmail.com
+
+*\brief Description:
+  Threaded stress test of SpscRing: one producer pushes 0, 1, 2, ... while
+  one consumer pops. The consumer must see every value exactly once and in
+  order. A small ring keeps both sides wrapping and hitting full and
+  empty. The string run adds heap-owning elements for the sanitizers.
+
+  Build and run from the repository root (tests/run_tests.sh does this):
+    g++ -std=c++17 -g -O1 -pthread -fsanitize=thread -I. tests/spsc_ring_test.cpp -o spsc_ring_test
+    ./spsc_ring_test
+
+******************************************************************************/
+
+//-----------------------------------------------------------------------------
+// Includes:
+//-----------------------------------------------------------------------------
+
+#include "check.h"
+#include "spsc_ring.h"
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <thread>
+
+//-----------------------------------------------------------------------------
+// Private Functions:
+//-----------------------------------------------------------------------------
+
+namespace {
+
+  // Push "count" numbered values through a ring of "capacity" slots
+  template <typename T, typename Make, typename Read>
+  void handoff(const char* name, std::size_t capacity, std::uint64_t count, Make make, Read read)
+  {
+    WrapBuffer::SpscRing<T> ring(capacity);
+
+    std::thread producer([&]
+    {
+      for (std::uint64_t i = 0; i < count; ++i)
+      {
+        T value = make(i);
+        while (!ring.Push_back(std::move(value)))
+        {
+          std::this_thread::yield();
+        }
+      }
+    });
+
+    std::uint64_t expected = 0;
+    T out{};
+    while (expected < count)
+    {
+      if (ring.Pop_front(out))
+      {
+        WB_CHECK(read(out) == expected);
+        ++expected;
+      }
+      else
+      {
+        std::this_thread::yield();
+      }
+    }
+    producer.join();
+
+    WB_CHECK(ring.Empty());
+    WB_CHECK(!ring.Pop_front(out));
+    std::printf("%-24s ok\n", name);
+  }
+
+}
+
+//-----------------------------------------------------------------------------
+// Public Functions:
+//-----------------------------------------------------------------------------
+
+int main()
+{
+  handoff<std::uint64_t>("SpscRing<uint64_t>", 64, 1000000,
+    [](std::uint64_t i) { return i; },
+    [](std::uint64_t v) { return v; });
+
+  handoff<std::string>("SpscRing<string>", 8, 100000,
+    [](std::uint64_t i) { return std::to_string(i) + "-heap-allocated-payload"; },
+    [](const std::string& s) { return std::stoull(s); });
+  return 0;
+}
+
+//-----------------------------------------------------------------------------
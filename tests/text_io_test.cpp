@@ -0,0 +1,73 @@
+/*!*****************************************************************************
+*\file     text_io_test.cpp
+*\author   Jalin A. Brown
+*\email    JalinBrownWorks@gmail.com
+
+*\brief Description:
+  Text I/O of Deque: operator<< output must read back through operator>>,
+  and a token that does not parse must stay in the stream.
+
+  Build and run from the repository root (tests/run_tests.sh does this):
+    g++ -std=c++17 -g -O1 -fsanitize=address,undefined -I. tests/text_io_test.cpp -o text_io_test
+    ./text_io_test
+
+******************************************************************************/
+
+//-----------------------------------------------------------------------------
+// Includes:
+//-----------------------------------------------------------------------------
+
+#include "check.h"
+#include "deque.h"
+#include <algorithm>
+#include <cstdio>
+#include <sstream>
+#include <string>
+
+//-----------------------------------------------------------------------------
+// Private Functions:
+//-----------------------------------------------------------------------------
+
+namespace {
+
+  using namespace WrapBuffer;
+
+  // write_text output reads back, and a bad token stays in the stream
+  void text_round_trip()
+  {
+    Deque<int> d;
+    for (int i = -500; i < 500; ++i)
+    {
+      d.Push_back(i * 7919);
+    }
+    std::stringstream text;
+    text << d;
+    Deque<int> back;
+    text >> back;
+    WB_CHECK(back.Size() == d.Size());
+    WB_CHECK(std::equal(back.begin(), back.end(), d.begin(), d.end()));
+
+    std::istringstream bad("1 +2 x 3");
+    Deque<int> partial;
+    bad >> partial;
+    WB_CHECK(partial.Size() == 2 && partial[1] == 2 && bad.fail());
+    bad.clear();
+    std::string rest;
+    std::getline(bad, rest);
+    WB_CHECK(rest == "x 3");
+    std::printf("%-24s ok\n", "text round trip");
+  }
+
+}
+
+//-----------------------------------------------------------------------------
+// Public Functions:
+//-----------------------------------------------------------------------------
+
+int main()
+{
+  text_round_trip();
+  return 0;
+}
+
+//-----------------------------------------------------------------------------
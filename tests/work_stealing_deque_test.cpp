@@ -0,0 +1,136 @@
+/*!*****************************************************************************
+*\file     work_stealing_deque_test.cpp
+*\author   Jalin A. Brown
+*\email    JalinBrownWorks@gmail.com
+
+*\brief Description:
+  Threaded stress test of WorkStealingDeque.
+
+  The owner pushes bursts of numbered items from a deque that starts at
+  capacity 2, so the array grows while thieves are reading it, and pops
+  some of each burst back itself. Three thieves steal until every item
+  is taken. Every item must be taken exactly once, by the owner or by
+  one thief, and the sum of the taken items must match.
+
+  Build and run from the repository root (tests/run_tests.sh does this):
+    g++ -std=c++17 -g -O1 -pthread -fsanitize=thread -I. tests/work_stealing_deque_test.cpp -o work_stealing_deque_test
+    ./work_stealing_deque_test
+
+******************************************************************************/
+
+//-----------------------------------------------------------------------------
+// Includes:
+//-----------------------------------------------------------------------------
+
+#include "check.h"
+#include "work_stealing_deque.h"
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <thread>
+#include <vector>
+
+//-----------------------------------------------------------------------------
+// Private Functions:
+//-----------------------------------------------------------------------------
+
+namespace {
+
+  const unsigned thieves = 3;
+  const std::uint32_t items = 200000;
+
+  //-------------------------------------------------------------------------
+
+  // Every item is taken once, by the owner or a thief
+  void stress()
+  {
+    WrapBuffer::WorkStealingDeque<std::uint32_t> deque(2);
+    std::unique_ptr<std::atomic<unsigned char>[]> seen(new std::atomic<unsigned char>[items]);
+    for (std::uint32_t i = 0; i < items; ++i)
+    {
+      seen[i].store(0, std::memory_order_relaxed);
+    }
+    std::atomic<std::uint32_t> taken{ 0 };
+    std::atomic<std::uint64_t> sum{ 0 };
+
+    auto take = [&seen, &taken, &sum](std::uint32_t item)
+    {
+      WB_CHECK(item < items);
+      WB_CHECK(seen[item].exchange(1) == 0);
+      sum.fetch_add(item, std::memory_order_relaxed);
+      taken.fetch_add(1, std::memory_order_relaxed);
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned t = 0; t < thieves; ++t)
+    {
+      threads.emplace_back([&deque, &taken, &take]
+      {
+        std::uint32_t item;
+        while (taken.load(std::memory_order_relaxed) < items)
+        {
+          if (deque.steal(item))
+          {
+            take(item);
+          }
+          else
+          {
+            std::this_thread::yield();
+          }
+        }
+      });
+    }
+
+    // Bursts of growing length, so the deque keeps growing, and the owner
+    // pops a third of each burst back.
+    std::uint32_t next = 0;
+    std::uint32_t burst = 1;
+    while (next < items)
+    {
+      for (std::uint32_t i = 0; i < burst && next < items; ++i)
+      {
+        deque.Push_back(next++);
+      }
+      std::uint32_t item;
+      for (std::uint32_t i = 0; i < burst / 3 && deque.Pop_back(item); ++i)
+      {
+        take(item);
+      }
+      burst = (burst % 4096) + 1;
+    }
+
+    // Race the thieves for whatever is left.
+    std::uint32_t item;
+    while (deque.Pop_back(item))
+    {
+      take(item);
+    }
+    for (std::thread& t : threads)
+    {
+      t.join();
+    }
+
+    for (std::uint32_t i = 0; i < items; ++i)
+    {
+      WB_CHECK(seen[i].load() == 1);
+    }
+    WB_CHECK(taken.load() == items);
+    WB_CHECK(sum.load() == std::uint64_t(items) * (items - 1) / 2);
+    WB_CHECK(deque.Empty());
+    std::printf("%-24s ok\n", "WorkStealingDeque stress");
+  }
+
+}
+
+//-----------------------------------------------------------------------------
+// Public Functions:
+//-----------------------------------------------------------------------------
+
+int main()
+{
+  stress();
+  return 0;
+}
+
+//-----------------------------------------------------------------------------
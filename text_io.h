@@ -0,0 +1,279 @@
+/*!*****************************************************************************
+*\file     text_io.h
+*\author   Jalin A. Brown
+*\email    JalinBrownWorks@gmail.com
+
+*\brief Description:
+  Bulk text formatting and parsing behind the Deque's operator<<, operator>>,
+  write_text() and read_text(). The other containers print through the same
+  detail::write_elements().
+
+  1) Writing: numbers are formatted with std::to_chars into a 16 KiB local
+     buffer, together with the separators, and the buffer is handed to the
+     stream with one write() whenever it fills. The per-element cost is the
+     conversion itself instead of a formatted stream insertion.
+
+  2) Reading: tokens are taken straight from the stream's buffer, parsed
+     with std::from_chars, and appended in batches with push_back_n().
+     Nothing past the current token is read, and a token that fails to
+     parse is put back, so the stream is left where a loop of operator>>
+     would leave it.
+
+  The fast path covers integers (other than bool and the character types)
+  and floating-point types. It is only taken while the stream has default
+  formatting (decimal, no width, no showpos, the classic locale), so the
+  text is the same as inserting each element with operator<<: floats use
+  the stream's precision in the "general" style. Any other type or stream
+  state goes through the stream one element at a time.
+
+******************************************************************************/
+
+#ifndef WRAPBUFFER_TEXT_IO_H
+#define WRAPBUFFER_TEXT_IO_H
+
+//-----------------------------------------------------------------------------
+// Includes:
+//-----------------------------------------------------------------------------
+
+#include <charconv>
+#include <cstddef>
+#include <cstring>
+#include <ios>
+#include <istream>
+#include <locale>
+#include <streambuf>
+#include <ostream>
+#include <string_view>
+#include <type_traits>
+
+//-----------------------------------------------------------------------------
+// Public Structures:
+//-----------------------------------------------------------------------------
+
+namespace WrapBuffer {
+
+  // Separators for write_text() and read_text()
+  struct TextFormat
+  {
+    std::string_view separator = " ";  // Written between two elements
+    std::string_view terminator = " "; // Written after the last element
+  };
+
+  //-----------------------------------------------------------------------------
+  // Private Structures:
+  //-----------------------------------------------------------------------------
+
+  namespace detail {
+
+    // Character types print as characters, not numbers
+    template <typename T>
+    constexpr bool is_character = std::is_same<T, char>::value || std::is_same<T, signed char>::value
+                               || std::is_same<T, unsigned char>::value || std::is_same<T, wchar_t>::value
+                               || std::is_same<T, char16_t>::value || std::is_same<T, char32_t>::value;
+
+    // Whether T is formatted and parsed with to_chars/from_chars
+    template <typename T>
+    constexpr bool fast_text = (std::is_integral<T>::value && !std::is_same<T, bool>::value && !is_character<T>)
+#ifdef __cpp_lib_to_chars
+                            || std::is_floating_point<T>::value
+#endif
+                            ;
+
+    //-------------------------------------------------------------------------
+
+    // Whether "s" formats numbers exactly like to_chars does
+    inline bool plain_stream(const std::ios_base& s)
+    {
+      const std::ios_base::fmtflags ignored = std::ios_base::skipws | std::ios_base::unitbuf | std::ios_base::boolalpha;
+      return (s.flags() & ~ignored) == std::ios_base::dec
+          && s.width() == 0
+          && s.precision() >= 0 && s.precision() <= 64
+          && s.getloc() == std::locale::classic();
+    }
+
+    //-------------------------------------------------------------------------
+
+    // Formats values and separators into a local buffer, writes it in chunks
+    class TextWriter
+    {
+    public:
+      explicit TextWriter(std::ostream& os_) : os(os_), precision(static_cast<int>(os_.precision())), used(0) {}
+
+      // Append one number
+      template <typename T>
+      void put_value(T value)
+      {
+        if (sizeof(buffer) - used < 128)
+        {
+          flush();
+        }
+
+        std::to_chars_result r;
+        if constexpr (std::is_floating_point<T>::value)
+        {
+          r = std::to_chars(buffer + used, buffer + sizeof(buffer), value, std::chars_format::general, precision);
+        }
+        else
+        {
+          r = std::to_chars(buffer + used, buffer + sizeof(buffer), value);
+        }
+        used = static_cast<std::size_t>(r.ptr - buffer);
+      }
+
+      // Append raw text
+      void put(std::string_view text)
+      {
+        if (sizeof(buffer) - used < text.size())
+        {
+          flush();
+          if (text.size() > sizeof(buffer))
+          {
+            os.write(text.data(), static_cast<std::streamsize>(text.size()));
+            return;
+          }
+        }
+        std::memcpy(buffer + used, text.data(), text.size());
+        used += text.size();
+      }
+
+      // Hand everything buffered to the stream
+      void flush()
+      {
+        if (used)
+        {
+          os.write(buffer, static_cast<std::streamsize>(used));
+          used = 0;
+        }
+      }
+
+    private:
+      std::ostream& os;     // Destination
+      int precision;        // Significant digits for floating point
+      std::size_t used;     // Bytes in "buffer"
+      char buffer[16384];   // Pending text
+    };
+
+    //-------------------------------------------------------------------------
+
+    // Splits a stream into tokens straight from its buffer, reading no
+    // further than the end of the current token
+    class TextReader
+    {
+      using traits = std::istream::traits_type;
+
+    public:
+      TextReader(std::istream& is_, std::string_view delimiters)
+        : buf(*is_.rdbuf()), delimiter(), length(0), truncated(false), eof(false)
+      {
+        for (unsigned char c : std::string_view(" \n\t\r\v\f"))
+        {
+          delimiter[c] = true;
+        }
+        for (unsigned char c : delimiters)
+        {
+          delimiter[c] = true;
+        }
+      }
+
+      // Next token, empty once the stream is exhausted. A leading '+' is
+      // dropped, as the stream's own extraction accepts it and from_chars
+      // does not.
+      std::string_view next()
+      {
+        traits::int_type c = buf.sgetc();
+        while (!traits::eq_int_type(c, traits::eof()) && is_delimiter(c))
+        {
+          c = buf.snextc();
+        }
+
+        length = 0;
+        truncated = false;
+        while (!traits::eq_int_type(c, traits::eof()) && !is_delimiter(c))
+        {
+          if (length == sizeof(token))
+          {
+            truncated = true;
+            break;
+          }
+          token[length++] = traits::to_char_type(c);
+          c = buf.snextc();
+        }
+        eof = traits::eq_int_type(c, traits::eof());
+
+        std::string_view text(token, length);
+        if (length > 1 && token[0] == '+' && token[1] != '-')
+        {
+          text.remove_prefix(1);
+        }
+        return text;
+      }
+
+      // Whether the last token did not fit and was cut short
+      bool cut_short() const { return truncated; }
+
+      // Put the last token back into the stream, as far as it allows
+      void unget()
+      {
+        while (length && !traits::eq_int_type(buf.sputbackc(token[length - 1]), traits::eof()))
+        {
+          --length;
+        }
+        eof = false;
+      }
+
+      // Whether the end of the stream was reached
+      bool at_eof() const { return eof; }
+
+    private:
+      bool is_delimiter(traits::int_type c) const
+      {
+        return delimiter[static_cast<unsigned char>(traits::to_char_type(c))];
+      }
+
+      std::streambuf& buf;   // Source
+      bool delimiter[256];   // Whitespace and separator characters
+      std::size_t length;    // Characters in "token"
+      bool truncated;        // Whether "token" is only the start of the token
+      bool eof;              // Whether the stream has run out
+      char token[256];       // Last token read
+    };
+
+    //-------------------------------------------------------------------------
+
+    // Write every element of "c" as text, for any container with Size()
+    // and for_each(). Behind each container's write_text and operator<<.
+    template <typename Container>
+    std::ostream& write_elements(std::ostream& os, const Container& c, const TextFormat& format)
+    {
+      using T = typename Container::value_type;
+      std::size_t left = c.Size();
+
+      if constexpr (fast_text<T>)
+      {
+        if (plain_stream(os))
+        {
+          // Format into a local buffer and hand it over in large writes.
+          TextWriter out(os);
+          c.for_each([&](const T& value)
+          {
+            out.put_value(value);
+            out.put(--left ? format.separator : format.terminator);
+          });
+          out.flush();
+          return os;
+        }
+      }
+
+      c.for_each([&](const T& value)
+      {
+        os << value << (--left ? format.separator : format.terminator);
+      });
+      return os;
+    }
+
+  }
+}
+
+#endif // WRAPBUFFER_TEXT_IO_H
+
+//-----------------------------------------------------------------------------
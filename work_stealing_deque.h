@@ -0,0 +1,273 @@
+/*!*****************************************************************************
+*\file     work_stealing_deque.h
+*\author   Jalin A. Brown
+*\email    JalinBrownWorks@gmail.com
+
+*\brief Description:
+  Chase-Lev work-stealing deque, following the weak-memory-model version by
+  Le, Pop, Cohen and Zappa Nardelli.
+
+  The owner thread pushes and pops at the back, any number of thief threads
+  steal from the front. The ring uses the Deque's "b" (front) and "e" (back)
+  indices as free-running signed counters over a power-of-two circular array,
+  so a slot is addressed as
+
+    array[i & (capacity - 1)];
+
+  1) Push_back: the owner writes the slot, then publishes "e + 1". When the
+     array is full it copies the live range [b, e) into an array twice the
+     size and swaps the pointer in. Thieves that still hold the old array
+     read the same values from it, so the owner never waits for them.
+
+  2) Pop_back: the owner reserves the last slot by lowering "e" first. Only
+     when it races a thief for the very last element does it need a CAS on
+     "b" to decide who gets it.
+
+  3) steal: a thief reads "b", "e" and the slot, then claims the element
+     with a CAS on "b". Losing the CAS means another thief or the owner got
+     there first, and steal() reports failure rather than retrying.
+
+  Push_back and Pop_back are lock-free for the owner and steal() is one
+  CAS. Retired arrays are kept until the deque is destroyed because a
+  thief may still be reading one.
+
+  Elements are read speculatively before they are claimed, so T must be
+  trivially copyable (a task pointer or handle, typically).
+
+******************************************************************************/
+
+#ifndef WRAPBUFFER_WORK_STEALING_DEQUE_H
+#define WRAPBUFFER_WORK_STEALING_DEQUE_H
+
+//-----------------------------------------------------------------------------
+// Includes:
+//-----------------------------------------------------------------------------
+
+#include "wrap_policy.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+//-----------------------------------------------------------------------------
+// Public Structures:
+//-----------------------------------------------------------------------------
+
+namespace WrapBuffer {
+
+  template <typename T>
+  class WorkStealingDeque
+  {
+    static_assert(std::is_trivially_copyable<T>::value, "WorkStealingDeque needs a trivially copyable T");
+
+  public:
+    using value_type = T;
+    using size_type  = std::size_t;
+
+    // Capacity CTOR, rounded up to a power of two
+    explicit WorkStealingDeque(size_type capacity_ = 64);
+
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+    // Owner: push a value to the back, growing the array if needed
+    void Push_back(T val);
+
+    // Owner: pop the value at the back into out, false if empty
+    bool Pop_back(T& out);
+
+    // Thief: take the value at the front into out, false if empty or lost a race
+    bool steal(T& out);
+
+    // Number of elements, approximate while other threads are running
+    size_type Size() const;
+
+    // Check if the deque is empty, approximate while other threads are running
+    bool Empty() const;
+
+    // Get the capacity of the current array
+    size_type Capacity() const;
+
+  private:
+    using index_type = std::int64_t;
+
+    // Circular array of atomically accessed slots
+    struct Ring
+    {
+      explicit Ring(size_type capacity_) : capacity(capacity_), slots(new std::atomic<T>[capacity_]) {}
+
+      T get(index_type i) const { return slots[PowerOfTwoWrap::index(i, capacity)].load(std::memory_order_relaxed); }
+      void put(index_type i, T val) { slots[PowerOfTwoWrap::index(i, capacity)].store(val, std::memory_order_relaxed); }
+
+      size_type capacity;                      // Number of slots, a power of two
+      std::unique_ptr<std::atomic<T>[]> slots; // Slot array
+    };
+
+    // Copy [front, back) into a ring twice the size and make it current
+    Ring* grow(Ring* old, index_type front, index_type back);
+
+    alignas(cache_line_size) std::atomic<index_type> b; // Front, advanced by thieves
+    alignas(cache_line_size) std::atomic<index_type> e; // Back, moved by the owner
+    alignas(cache_line_size) std::atomic<Ring*> array;  // Current ring
+    std::vector<std::unique_ptr<Ring>> rings;            // Every ring allocated, owner only
+  };
+
+  //-----------------------------------------------------------------------------
+  // Public Functions:
+  //-----------------------------------------------------------------------------
+
+  // Capacity CTOR, rounded up to a power of two
+  template <typename T>
+  WorkStealingDeque<T>::WorkStealingDeque(size_type capacity_) : b(0), e(0), array(nullptr)
+  {
+    rings.emplace_back(new Ring(PowerOfTwoWrap::round_capacity(capacity_ ? capacity_ : 1)));
+    array.store(rings.back().get(), std::memory_order_relaxed);
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Owner: push a value to the back, growing the array if needed
+  template <typename T>
+  void WorkStealingDeque<T>::Push_back(T val)
+  {
+    index_type back = e.load(std::memory_order_relaxed);
+    index_type front = b.load(std::memory_order_acquire);
+    Ring* ring = array.load(std::memory_order_relaxed);
+
+    // Check if the ring is full and needs to grow
+    if (back - front > static_cast<index_type>(ring->capacity) - 1)
+    {
+      ring = grow(ring, front, back);
+    }
+
+    ring->put(back, val);
+
+    // Make the slot visible before the new back index.
+    std::atomic_thread_fence(std::memory_order_release);
+    e.store(back + 1, std::memory_order_relaxed);
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Owner: pop the value at the back into out, false if empty
+  template <typename T>
+  bool WorkStealingDeque<T>::Pop_back(T& out)
+  {
+    // Reserve the last slot before looking at the front.
+    index_type back = e.load(std::memory_order_relaxed) - 1;
+    Ring* ring = array.load(std::memory_order_relaxed);
+    e.store(back, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    index_type front = b.load(std::memory_order_relaxed);
+
+    if (front > back)
+    {
+      // Empty: undo the reservation.
+      e.store(back + 1, std::memory_order_relaxed);
+      return false;
+    }
+
+    T val = ring->get(back);
+    if (front == back)
+    {
+      // Last element: race the thieves for it.
+      bool won = b.compare_exchange_strong(front, front + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+      e.store(back + 1, std::memory_order_relaxed);
+      if (!won)
+      {
+        return false;
+      }
+    }
+
+    out = val;
+    return true;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Thief: take the value at the front into out, false if empty or lost a race
+  template <typename T>
+  bool WorkStealingDeque<T>::steal(T& out)
+  {
+    index_type front = b.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    index_type back = e.load(std::memory_order_acquire);
+
+    if (front >= back)
+    {
+      return false;
+    }
+
+    // Read before claiming, the CAS tells whether the read counts.
+    Ring* ring = array.load(std::memory_order_acquire);
+    T val = ring->get(front);
+    if (!b.compare_exchange_strong(front, front + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+    {
+      return false;
+    }
+
+    out = val;
+    return true;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Number of elements, approximate while other threads are running
+  template <typename T>
+  typename WorkStealingDeque<T>::size_type WorkStealingDeque<T>::Size() const
+  {
+    index_type front = b.load(std::memory_order_relaxed);
+    index_type back = e.load(std::memory_order_relaxed);
+    return (back > front) ? static_cast<size_type>(back - front) : 0;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Check if the deque is empty, approximate while other threads are running
+  template <typename T>
+  bool WorkStealingDeque<T>::Empty() const
+  {
+    return Size() == 0;
+  }
+
+  //-------------------------------------------------------------------------
+
+  // Get the capacity of the current array
+  template <typename T>
+  typename WorkStealingDeque<T>::size_type WorkStealingDeque<T>::Capacity() const
+  {
+    return array.load(std::memory_order_relaxed)->capacity;
+  }
+
+  //-------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// Private Functions:
+//-----------------------------------------------------------------------------
+
+  // Copy [front, back) into a ring twice the size and make it current
+  template <typename T>
+  typename WorkStealingDeque<T>::Ring* WorkStealingDeque<T>::grow(Ring* old, index_type front, index_type back)
+  {
+    // The indices stay the same, only the mask changes.
+    rings.emplace_back(new Ring(old->capacity * 2));
+    Ring* bigger = rings.back().get();
+    for (index_type i = front; i < back; ++i)
+    {
+      bigger->put(i, old->get(i));
+    }
+
+    // Thieves that load the new pointer must see the copied slots.
+    array.store(bigger, std::memory_order_release);
+    return bigger;
+  }
+
+  //-------------------------------------------------------------------------
+
+}
+
+#endif // WRAPBUFFER_WORK_STEALING_DEQUE_H
+
+//-----------------------------------------------------------------------------
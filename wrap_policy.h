@@ -0,0 +1,59 @@
+/*!*****************************************************************************
+*\file     wrap_policy.h
+*\author   Jalin A. Brown
+*\email    JalinBrownWorks@gmail.com
+
+*\brief Description:
+  Index wrapping policies shared by the Deque and the fixed-capacity rings,
+  and the cache line size the lock-free rings align their indices to.
+
+  This header has no other dependencies, so SpscRing, MpmcRing and
+  WorkStealingDeque can use the wrap step without pulling in the Deque.
+
+******************************************************************************/
+
+#ifndef WRAPBUFFER_WRAP_POLICY_H
+#define WRAPBUFFER_WRAP_POLICY_H
+
+//-----------------------------------------------------------------------------
+// Includes:
+//-----------------------------------------------------------------------------
+
+#include <cstddef>
+
+//-----------------------------------------------------------------------------
+// Public Structures:
+//-----------------------------------------------------------------------------
+
+namespace WrapBuffer {
+
+  // Size that keeps independently written data from sharing a cache line
+  constexpr std::size_t cache_line_size = 64;
+
+  // Wraps with "% capacity", any capacity is allowed
+  struct ModuloWrap
+  {
+    static std::size_t index(std::size_t x, std::size_t capacity) { return x % capacity; }
+    static constexpr std::size_t round_capacity(std::size_t n) { return n; }
+  };
+
+  // Wraps with "& (capacity - 1)", capacities are rounded up to a power of two
+  struct PowerOfTwoWrap
+  {
+    static std::size_t index(std::size_t x, std::size_t capacity) { return x & (capacity - 1); }
+    static constexpr std::size_t round_capacity(std::size_t n) 
+    {
+      std::size_t rounded = 1;
+      while (rounded < n) 
+      {
+        rounded <<= 1;
+      }
+      return n ? rounded : 0;
+    }
+  };
+
+}
+
+#endif // WRAPBUFFER_WRAP_POLICY_H
+
+//-----------------------------------------------------------------------------